@@ -6,6 +6,7 @@
 #include "ltps/base/Config.h"
 #include "ltps/common/EconomySystem.h"
 #include "ltps/database/PermissionStorage.h"
+#include "ltps/database/PlayerRegistry.h"
 #include "ltps/database/StorageManager.h"
 #include "ltps/modules/ModuleManager.h"
 #include "ltps/modules/home/HomeModule.h"
@@ -55,13 +56,15 @@ bool TeleportSystem::load() {
     );
     mStorageManager = std::unique_ptr<StorageManager>(new StorageManager(*mThreadPool));
     mModuleManager  = std::unique_ptr<ModuleManager>(new ModuleManager());
+    mSessionManager = std::make_unique<SessionManager>();
 
     // 初始化全局配置
     loadConfig();
 
     EconomySystemManager::getInstance().initEconomySystem();
 
-    // 注册 Storage
+    // 注册 Storage (PlayerRegistry 必须最先注册)
+    mStorageManager->registerStorage<PlayerRegistry>();
     mStorageManager->registerStorage<PermissionStorage>();
     mStorageManager->registerStorage<setting::SettingStorage>();
     mStorageManager->registerStorage<home::HomeStorage>();
@@ -82,6 +85,9 @@ bool TeleportSystem::load() {
 }
 
 bool TeleportSystem::enable() {
+    mTeleportDispatcher = std::make_unique<TeleportDispatcher>(*mServerThreadExecutor);
+
+    mSessionManager->attach();       // 玩家会话
     mModuleManager->enableModules(); // 启用模块
     BaseCommand::setup();            // 基础命令
 
@@ -94,10 +100,13 @@ bool TeleportSystem::enable() {
 
 bool TeleportSystem::disable() {
     mModuleManager->disableModules(); // 禁用模块
+    mSessionManager->detach();        // 销毁玩家会话
     mStorageManager->postUnload();    // 卸载 Storage
 
 
     mModuleManager.reset();        // 销毁模块管理器指针
+    mSessionManager.reset();       // 销毁会话管理器指针
+    mTeleportDispatcher.reset();   // 销毁传送分发队列（丢弃排队的传送）
     mStorageManager.reset();       // 销毁 Storage 指针
     mServerThreadExecutor.reset(); // 销毁 Server 线程池指针
     mThreadPool->destroy();        // 销毁线程池
@@ -118,6 +127,9 @@ ll::thread::ServerThreadExecutor const& TeleportSystem::getServerThreadExecutor(
 }
 StorageManager& TeleportSystem::getStorageManager() { return *mStorageManager; }
 ModuleManager&  TeleportSystem::getModuleManager() { return *mModuleManager; }
+SessionManager& TeleportSystem::getSessionManager() { return *mSessionManager; }
+
+TeleportDispatcher& TeleportSystem::getTeleportDispatcher() { return *mTeleportDispatcher; }
 
 } // namespace ltps
 
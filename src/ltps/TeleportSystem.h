@@ -4,6 +4,8 @@
 #include "ll/api/mod/NativeMod.h"
 #include "ll/api/thread/ThreadPoolExecutor.h"
 
+#include "ltps/common/PlayerSession.h"
+#include "ltps/common/TeleportDispatcher.h"
 #include "ltps/database/StorageManager.h"
 #include "ltps/modules/ModuleManager.h"
 
@@ -34,6 +36,10 @@ class TeleportSystem {
 
     [[nodiscard]] ModuleManager& getModuleManager();
 
+    [[nodiscard]] SessionManager& getSessionManager();
+
+    [[nodiscard]] TeleportDispatcher& getTeleportDispatcher();
+
 private:
     explicit TeleportSystem();
 
@@ -42,6 +48,8 @@ class TeleportSystem {
     std::unique_ptr<ll::thread::ServerThreadExecutor> mServerThreadExecutor;
     std::unique_ptr<StorageManager>                   mStorageManager;
     std::unique_ptr<ModuleManager>                    mModuleManager;
+    std::unique_ptr<SessionManager>                   mSessionManager;
+    std::unique_ptr<TeleportDispatcher>               mTeleportDispatcher;
 };
 
 } // namespace ltps
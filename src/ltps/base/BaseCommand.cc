@@ -9,10 +9,13 @@
 #include "ltps/database/StorageManager.h"
 #include "ltps/modules/ModuleManager.h"
 #include "ltps/modules/setting/gui/SettingGUI.h"
+#include "ltps/modules/tpr/TprModule.h"
+#include "ltps/modules/warp/WarpModule.h"
 #include "ltps/utils/McUtils.h"
 #include "mc/server/commands/CommandOrigin.h"
 #include "mc/server/commands/CommandOriginType.h"
 #include "mc/server/commands/CommandOutput.h"
+#include <chrono>
 
 
 namespace ltps {
@@ -73,6 +76,65 @@ void BaseCommand::setup() {
         mc_utils::sendText(output, "配置已重载"_tr());
     });
 
+    // ltps stats
+    cmd.overload().text("stats").execute([](CommandOrigin const& origin, CommandOutput& output) {
+        if (origin.getOriginType() != CommandOriginType::DedicatedServer) {
+            mc_utils::sendText<mc_utils::Error>(output, "此命令只能在服务器端执行"_tr());
+            return;
+        }
+
+        using std::chrono::duration_cast;
+        using std::chrono::milliseconds;
+
+        auto const& dispatch = TeleportSystem::getInstance().getTeleportDispatcher().getMetrics();
+        auto        deferred = static_cast<long long>(dispatch.deferred);
+        auto        avgDelay = deferred == 0 ? 0 : duration_cast<milliseconds>(dispatch.totalWait).count() / deferred;
+        mc_utils::sendText(
+            output,
+            "传送分发: 排队 {0} (峰值 {1}), 立即执行 {2}, 排队执行 {3}, 丢弃 {4}, 平均等待 {5}ms, 最长等待 {6}ms"_tr(
+                dispatch.queued,
+                dispatch.peakQueued,
+                dispatch.immediate,
+                dispatch.deferred,
+                dispatch.dropped,
+                avgDelay,
+                duration_cast<milliseconds>(dispatch.maxWait).count()
+            )
+        );
+
+        auto* warp =
+            TeleportSystem::getInstance().getModuleManager().getModule<warp::WarpModule>(warp::WarpModule::name);
+        if (auto* warmer = warp && warp->isEnabled() ? warp->getChunkWarmer() : nullptr) {
+            mc_utils::sendText(output, "Warp 预热区块: 已就绪 {0} / 持有 {1}"_tr(warmer->readyCount(), warmer->size()));
+        }
+
+        auto* tpr = TeleportSystem::getInstance().getModuleManager().getModule<tpr::TprModule>(tpr::TprModule::name);
+        if (!tpr || !tpr->isEnabled() || !tpr->getSafeTeleport()) {
+            mc_utils::sendText(output, "Tpr 模块未启用"_tr());
+            return;
+        }
+
+        auto metrics = tpr->getSafeTeleport()->getQueueMetrics();
+        auto avgWait = metrics.admitted == 0 ? 0 : metrics.totalWait.count() / static_cast<long long>(metrics.admitted);
+        mc_utils::sendText(
+            output,
+            "Tpr 区块加载: 排队 {0} (峰值 {1}), 加载中 {2}, 累计放行 {3}, 平均等待 {4}ms, 最长等待 {5}ms"_tr(
+                metrics.queued,
+                metrics.peakQueued,
+                metrics.loading,
+                metrics.admitted,
+                avgWait,
+                metrics.maxWait.count()
+            )
+        );
+        mc_utils::sendText(output, "Tpr 已拒绝区域: {0}"_tr(tpr->getSafeTeleport()->getRejectedRegions().size()));
+        auto const& biomes = tpr->getSafeTeleport()->getBiomeScreen().getMetrics();
+        mc_utils::sendText(
+            output,
+            "Tpr 群系预筛选: 检查 {0}, 拒绝 {1}, 无法查询 {2}"_tr(biomes.checked, biomes.rejected, biomes.unavailable)
+        );
+    });
+
     // ltps setting
     cmd.overload().text("setting").execute([](CommandOrigin const& origin, CommandOutput& output) {
         if (origin.getOriginType() != CommandOriginType::Player) {
@@ -2,8 +2,10 @@
 #include "ll/api/io/LogLevel.h"
 #include "ltps/Global.h"
 #include "ltps/common/EconomySystem.h"
+#include "ltps/common/RateLimiter.h"
 #include <filesystem>
 #include <unordered_set>
+#include <vector>
 
 
 namespace ltps::inline config {
@@ -17,9 +19,23 @@ namespace v5 {
 
 using DisallowedDimensions = std::unordered_set<int>;
 
+// Tpr 排除区域
+struct ExclusionZone {
+    int  x        = 0;
+    int  z        = 0;
+    int  radius   = 100;
+    bool isCircle = true; // true: 圆形  false: 方形
+};
+
 struct Config {
-    int              version  = 11;
+    int                   version = 24;
     EconomySystem::Config economySystem{};
+    RateLimiter::Config   rateLimit{}; // 请求限流（令牌桶）
+
+    struct {
+        bool enable        = true;
+        int  perTickBudget = 8; // 每 tick 最多执行的传送次数，超出的按目标维度排队
+    } teleportDispatch;
 
     struct {
         struct {
@@ -27,6 +43,7 @@ struct Config {
             std::string          createRequestCalculate = "random_num_range(10, 60)"; // 创建请求价格
             int                  cooldownTime           = 10;                         // 发起请求冷却时间（秒）
             int                  expirationTime         = 120;                        // 请求过期时间（秒）
+            int                  batchFormsPerTick      = 10;                         // 批量请求每 tick 发送的表单数量
             DisallowedDimensions disallowedDimensions   = {};                         // 禁用此功能的维度
         } tpa;
 
@@ -45,6 +62,18 @@ struct Config {
             int                  cooldownTime         = 10; // 冷却时间（秒, 对于玩家）
             std::string          goWarpCalculate      = "random_num_range(10, 60)";
             DisallowedDimensions disallowedDimensions = {};
+            struct {
+                bool   rankMenus    = false; // 传送点菜单与 /warp list 按使用热度排序
+                double halfLifeDays = 7.0;   // 热度半衰期（天）
+            } usage;
+            struct {
+                bool                     enable         = false;
+                std::vector<std::string> warps          = {}; // 始终预热的传送点
+                int                      topUsed        = 3;  // 另外预热使用热度最高的 N 个传送点
+                int                      chunkRadius    = 1;  // 传送点周围预热的区块半径
+                int                      maxChunks      = 64; // 最多常驻的区块个数（不是内存大小）
+                int                      refreshSeconds = 60; // 重新选择预热区块的间隔（秒）
+            } preload;
         } warp;
 
         struct {
@@ -70,6 +99,45 @@ struct Config {
                 "minecraft:fire",
             };
 
+            struct {
+                int  maxColumns          = 64;    // 目标列没有安全位置时，最多额外检查的列数
+                bool allowAdjacentChunks = false; // 允许检查已加载的相邻区块
+            } neighborSearch;
+
+            int maxConcurrentChunkLoads  = 4;    // 每个维度同时加载的区块数上限，超出的任务排队等待
+            int searchBlockBudgetPerTick = 2048; // 所有安全位置查找每 tick 共享的方块复制预算（服务器线程）
+
+            struct {
+                bool enable              = false;
+                int  size                = 8;   // 每个维度预选的目的地数量
+                int  refillIntervalTicks = 40;  // 补充间隔（tick），每次最多加载一个候选区块
+                int  ttlSeconds          = 600; // 目的地有效期（秒）
+            } pool;
+
+            struct {
+                bool enable       = true;
+                int  cellSize     = 32;   // 网格边长（方块）
+                int  capacity     = 4096; // 最多记录的网格数
+                int  ttlSeconds   = 1800; // 记录有效期（秒）
+                int  maxResamples = 8;    // 随机点落在已拒绝区域时最多重新选点次数
+            } rejectedRegions;
+
+            struct {
+                bool                            enable       = true;
+                bool                            rejectOceans = true; // 拒绝海洋类群系
+                bool                            rejectRivers = true; // 拒绝河流类群系
+                std::unordered_set<std::string> blacklist    = {};   // 拒绝的群系名，如 "minecraft:deep_dark"
+                int                             maxResamples = 16;   // 随机点被拒绝时最多重新选点次数
+            } biomeScreen;
+
+            struct {
+                bool enable             = false;
+                int  radius             = 32; // 邻域半径（方块）
+                int  minDistance        = 24; // 同一邻域内分配点之间的最小距离
+                int  maxPerNeighborhood = 4;  // 每个邻域最多分配的请求数（含首次加载）
+                int  windowSeconds      = 30; // 邻域有效时间（秒）
+            } coalesce;
+
             struct {
                 bool enable = false;
                 bool isCircle = true; // true: Circle  false: CenteredSquare
@@ -77,12 +145,15 @@ struct Config {
                 struct {
                     int  x                       = 0;     // 圆心或矩形的中心点
                     int  z                       = 0;     // 圆心或矩形的中心点
-                    int  radius                  = 100;   // 半径或矩形的边长
+                    int  radius                  = 100;   // 半径或矩形的半边长
+                    int  minRadius               = 0;     // 距中心的最小距离（环形区域），0 为不限制
                     bool usePlayerPositionCenter = false; // 使用玩家当前的位置作为中心点
                 } center;
 
             } restrictedAreas;
 
+            std::vector<ExclusionZone> exclusionZones = {}; // 排除区域（如出生点），不会传送到区域内
+
             DisallowedDimensions disallowedDimensions = {};
         } tpr;
 
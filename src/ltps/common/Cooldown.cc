@@ -5,45 +5,159 @@
 namespace ltps {
 
 
-Cooldown::Cooldown() = default;
+// CooldownTable
+CooldownTable::CooldownTable() = default;
 
+CooldownTable& CooldownTable::getInstance() {
+    static CooldownTable instance;
+    return instance;
+}
 
-bool Cooldown::isCooldown(const std::string& target) const {
-    auto it = mCooldowns.find(target);
-    if (it == mCooldowns.end()) {
-        return false;
+bool CooldownTable::_isExpired(Row const& row, Clock::time_point now) const {
+    return std::all_of(row.mExpireAt.begin(), row.mExpireAt.end(), [now](auto const& t) { return t <= now; });
+}
+
+void CooldownTable::_release(Id id) {
+    auto& row = mRows[id];
+    mIndex.erase(row.mRealName);
+    row = Row{};
+    mFreeIds.push_back(id);
+}
+
+void CooldownTable::_sweep(Clock::time_point now) {
+    if (mRows.empty()) {
+        return;
     }
+    for (std::size_t i = 0; i < SweepStep; ++i) {
+        if (mSweepCursor >= mRows.size()) {
+            mSweepCursor = 0;
+        }
+        auto  id  = static_cast<Id>(mSweepCursor++);
+        auto& row = mRows[id];
+        if (row.mUsed && row.mPinCount == 0 && _isExpired(row, now)) {
+            _release(id);
+        }
+    }
+}
 
-    auto now = std::chrono::steady_clock::now();
-    return now < it->second;
+CooldownTable::Id CooldownTable::findId(RealName const& realName) const {
+    auto iter = mIndex.find(realName);
+    return iter == mIndex.end() ? InvalidId : iter->second;
 }
 
+CooldownTable::Id CooldownTable::getOrCreateId(RealName const& realName) {
+    if (auto id = findId(realName); id != InvalidId) {
+        return id;
+    }
+
+    Id id;
+    if (!mFreeIds.empty()) {
+        id = mFreeIds.back();
+        mFreeIds.pop_back();
+    } else {
+        id = static_cast<Id>(mRows.size());
+        mRows.emplace_back();
+    }
 
-void Cooldown::setCooldown(const std::string& target, int seconds) {
-    auto endTime       = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
-    mCooldowns[target] = endTime;
+    auto& row     = mRows[id];
+    row.mRealName = realName;
+    row.mUsed     = true;
+    mIndex.emplace(realName, id);
+    return id;
 }
 
+void CooldownTable::pin(Id id) {
+    if (id < mRows.size() && mRows[id].mUsed) {
+        ++mRows[id].mPinCount;
+    }
+}
 
-int Cooldown::getRemainingCooldown(const std::string& target) const {
-    auto it = mCooldowns.find(target);
-    if (it == mCooldowns.end()) {
+void CooldownTable::unpin(Id id) {
+    if (id < mRows.size() && mRows[id].mUsed && mRows[id].mPinCount > 0) {
+        --mRows[id].mPinCount;
+    }
+}
+
+bool CooldownTable::isCooldown(Id id, Column column) const {
+    if (id >= mRows.size()) {
+        return false;
+    }
+    return Clock::now() < mRows[id].mExpireAt[static_cast<std::size_t>(column)];
+}
+
+void CooldownTable::setCooldown(Id id, Column column, int seconds) {
+    if (id >= mRows.size() || !mRows[id].mUsed) {
+        return;
+    }
+    auto now = Clock::now();
+
+    mRows[id].mExpireAt[static_cast<std::size_t>(column)] = now + std::chrono::seconds(seconds);
+    _sweep(now);
+}
+
+int CooldownTable::getRemainingCooldown(Id id, Column column) const {
+    if (id >= mRows.size()) {
         return 0;
     }
 
-    auto now = std::chrono::steady_clock::now();
-    if (now >= it->second) {
+    auto now     = Clock::now();
+    auto expires = mRows[id].mExpireAt[static_cast<std::size_t>(column)];
+    if (now >= expires) {
         return 0;
     }
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(expires - now).count());
+}
+
+std::size_t CooldownTable::size() const { return mIndex.size(); }
+
+void CooldownTable::clear() {
+    mIndex.clear();
+    mRows.clear();
+    mFreeIds.clear();
+    mSweepCursor = 0;
+}
+
+
+// Cooldown
+Cooldown::Cooldown(CooldownTable::Column column) : mColumn(column) {}
+
+CooldownTable::Column Cooldown::getColumn() const { return mColumn; }
+
+
+bool Cooldown::isCooldown(const std::string& target) const {
+    return isCooldown(CooldownTable::getInstance().findId(target));
+}
+
+bool Cooldown::isCooldown(CooldownTable::Id id) const { return CooldownTable::getInstance().isCooldown(id, mColumn); }
 
-    auto remaining = std::chrono::duration_cast<std::chrono::seconds>(it->second - now).count();
-    return static_cast<int>(remaining);
+
+void Cooldown::setCooldown(const std::string& target, int seconds) {
+    setCooldown(CooldownTable::getInstance().getOrCreateId(target), seconds);
+}
+
+void Cooldown::setCooldown(CooldownTable::Id id, int seconds) {
+    CooldownTable::getInstance().setCooldown(id, mColumn, seconds);
+}
+
+
+int Cooldown::getRemainingCooldown(const std::string& target) const {
+    return getRemainingCooldown(CooldownTable::getInstance().findId(target));
+}
+
+int Cooldown::getRemainingCooldown(CooldownTable::Id id) const {
+    return CooldownTable::getInstance().getRemainingCooldown(id, mColumn);
 }
 
 
 std::string Cooldown::getCooldownString(const std::string& target) const {
-    int remainingSeconds = getRemainingCooldown(target);
+    return formatCooldown(getRemainingCooldown(target));
+}
+
+std::string Cooldown::getCooldownString(CooldownTable::Id id) const {
+    return formatCooldown(getRemainingCooldown(id));
+}
 
+std::string Cooldown::formatCooldown(int remainingSeconds) {
     if (remainingSeconds <= 0) {
         return "0s";
     }
@@ -55,4 +169,4 @@ std::string Cooldown::getCooldownString(const std::string& target) const {
 }
 
 
-} // namespace ltps
\ No newline at end of file
+} // namespace ltps
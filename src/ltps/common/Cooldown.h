@@ -1,34 +1,121 @@
 #pragma once
 #include "ltps/Global.h"
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 
 namespace ltps {
 
 
+/**
+ * @brief 共享冷却表
+ * Home / Warp / Tpa / Tpr 共用一张表，每个模块占一列；玩家名只在首次写入时哈希一次，
+ * 之后映射为紧凑的行号 (Id)，可直接按 Id 查询。
+ * 每次写入顺带摊还扫描若干行，所有列均已过期且未被持有的行会被回收，表大小只与活跃玩家数相关。
+ */
+class CooldownTable final {
+public:
+    enum class Column : uint8_t {
+        Home = 0,
+        Warp,
+        Tpa,
+        Tpr,
+        Count // 列数量
+    };
+
+    using Id = uint32_t;
+
+    static inline constexpr Id InvalidId = static_cast<Id>(-1);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static inline constexpr std::size_t ColumnCount = static_cast<std::size_t>(Column::Count);
+    static inline constexpr std::size_t SweepStep   = 4; // 每次写入顺带检查的行数
+
+    struct Row {
+        std::array<Clock::time_point, ColumnCount> mExpireAt{}; // 默认值(纪元)即为未冷却
+        RealName                                   mRealName;
+        uint32_t                                   mPinCount{0}; // 持有者数量，被持有的行不会被回收
+        bool                                       mUsed{false};
+    };
+
+    std::unordered_map<RealName, Id> mIndex;
+    std::vector<Row>                 mRows;
+    std::vector<Id>                  mFreeIds;
+    std::size_t                      mSweepCursor{0};
+
+    explicit CooldownTable();
+
+    bool _isExpired(Row const& row, Clock::time_point now) const;
+    void _release(Id id);
+    void _sweep(Clock::time_point now);
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(CooldownTable);
+
+    TPSNDAPI static CooldownTable& getInstance();
+
+    // 查找玩家行号，不存在返回 InvalidId
+    TPSNDAPI Id findId(RealName const& realName) const;
+
+    // 获取或分配玩家行号
+    TPSNDAPI Id getOrCreateId(RealName const& realName);
+
+    // 持有 / 释放行号，持有期间行号保持有效（如玩家会话缓存 Id）
+    TPSAPI void pin(Id id);
+    TPSAPI void unpin(Id id);
+
+    TPSNDAPI bool isCooldown(Id id, Column column) const;
+
+    TPSAPI void setCooldown(Id id, Column column, int seconds);
+
+    TPSNDAPI int getRemainingCooldown(Id id, Column column) const;
+
+    // 当前占用的行数
+    TPSNDAPI std::size_t size() const;
+
+    TPSAPI void clear();
+};
+
+
+/**
+ * @brief 模块冷却（CooldownTable 的列视图）
+ */
 class Cooldown {
 private:
-    std::unordered_map<std::string, std::chrono::steady_clock::time_point> mCooldowns;
+    CooldownTable::Column mColumn;
 
 public:
     TPS_DISALLOW_COPY_AND_MOVE(Cooldown)
 
-    TPSAPI explicit Cooldown();
+    TPSAPI explicit Cooldown(CooldownTable::Column column);
+
+    TPSNDAPI CooldownTable::Column getColumn() const;
 
     // 是否正在冷却中
     TPSNDAPI bool isCooldown(const std::string& target) const;
+    TPSNDAPI bool isCooldown(CooldownTable::Id id) const;
 
     // 设置冷却时间
     TPSAPI void setCooldown(const std::string& target, int seconds);
+    TPSAPI void setCooldown(CooldownTable::Id id, int seconds);
 
     // 获取剩余冷却时间
     TPSNDAPI int getRemainingCooldown(const std::string& target) const;
+    TPSNDAPI int getRemainingCooldown(CooldownTable::Id id) const;
 
     // 获取冷却字符串
     TPSNDAPI std::string getCooldownString(const std::string& target) const;
+    TPSNDAPI std::string getCooldownString(CooldownTable::Id id) const;
+
+    TPSNDAPI static std::string formatCooldown(int remainingSeconds);
 };
 
 
-} // namespace ltps
\ No newline at end of file
+} // namespace ltps
@@ -0,0 +1,58 @@
+#include "ltps/common/FormCache.h"
+#include <algorithm>
+
+
+namespace ltps {
+
+
+FormCache::FormCache() = default;
+
+FormCache& FormCache::getInstance() {
+    static FormCache instance;
+    return instance;
+}
+
+std::string FormCache::makeKey(std::string_view kind, std::string_view localeCode) {
+    std::string key;
+    key.reserve(kind.size() + localeCode.size() + 1);
+    key.append(kind).push_back('\0');
+    key.append(localeCode);
+    return key;
+}
+
+FormCache::FormPtr FormCache::_find(std::string const& key, std::uint64_t version) {
+    auto iter = mEntries.find(key);
+    if (iter == mEntries.end() || iter->second.version != version) {
+        if (iter != mEntries.end()) {
+            mEntries.erase(iter); // 版本已过期
+        }
+        mMetrics.misses++;
+        return nullptr;
+    }
+    mMetrics.hits++;
+    iter->second.lastUsed = ++mUseCounter;
+    return iter->second.form;
+}
+
+void FormCache::_insert(std::string key, std::uint64_t version, FormPtr form) {
+    if (mEntries.size() >= MaxEntries && !mEntries.contains(key)) {
+        auto oldest = std::min_element(mEntries.begin(), mEntries.end(), [](auto const& a, auto const& b) {
+            return a.second.lastUsed < b.second.lastUsed;
+        });
+        mEntries.erase(oldest);
+    }
+    mEntries.insert_or_assign(std::move(key), Entry{version, std::move(form), ++mUseCounter});
+}
+
+void FormCache::invalidate(std::string_view prefix) {
+    std::erase_if(mEntries, [&](auto const& pair) { return pair.first.starts_with(prefix); });
+}
+
+void FormCache::clear() { mEntries.clear(); }
+
+std::size_t FormCache::size() const { return mEntries.size(); }
+
+FormCache::Metrics const& FormCache::getMetrics() const { return mMetrics; }
+
+
+} // namespace ltps
@@ -0,0 +1,83 @@
+#pragma once
+#include "ltps/Global.h"
+#include "ltps/common/BackSimpleForm.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+
+namespace ltps {
+
+
+/**
+ * @brief 已构建表单缓存（按 表单类型 + 语言 缓存，附带数据版本）
+ * 只缓存不含玩家状态的表单（按钮回调不捕获玩家数据），同一份表单可重复发送给不同玩家。
+ * 数据版本与缓存不一致时重新构建，Storage 修改时递增版本即可使缓存失效。
+ * 查找时移除版本过期的表单，超出 MaxEntries 时淘汰最久未使用的表单。
+ */
+class FormCache final {
+public:
+    using FormPtr = std::shared_ptr<BackSimpleForm>;
+
+    struct Metrics {
+        std::size_t hits{0};   // 命中
+        std::size_t misses{0}; // 构建
+    };
+
+private:
+    struct Entry {
+        std::uint64_t version;
+        FormPtr       form;
+        std::uint64_t lastUsed; // 最近使用序号
+    };
+
+    static inline constexpr std::size_t MaxEntries = 512;
+
+    std::unordered_map<std::string, Entry> mEntries; // kind + '\0' + localeCode
+    Metrics                                mMetrics;
+    std::uint64_t                          mUseCounter{0};
+
+    explicit FormCache();
+
+    static std::string makeKey(std::string_view kind, std::string_view localeCode);
+
+    FormPtr _find(std::string const& key, std::uint64_t version);
+    void    _insert(std::string key, std::uint64_t version, FormPtr form);
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(FormCache);
+
+    TPSNDAPI static FormCache& getInstance();
+
+    /**
+     * @brief 获取缓存的表单，版本不一致或不存在时调用 build 构建并缓存
+     * @param build FormPtr()
+     */
+    template <typename Fn>
+    [[nodiscard]] FormPtr
+    getOrBuild(std::string_view kind, std::string_view localeCode, std::uint64_t version, Fn&& build) {
+        auto key = makeKey(kind, localeCode);
+        if (auto form = _find(key, version)) {
+            return form;
+        }
+        auto form = FormPtr{build()};
+        _insert(std::move(key), version, form);
+        return form;
+    }
+
+    // 清除类型以 prefix 开头的所有缓存（所有语言），如 "warp."
+    TPSAPI void invalidate(std::string_view prefix);
+
+    TPSAPI void clear();
+
+    TPSNDAPI std::size_t size() const;
+
+    TPSNDAPI Metrics const& getMetrics() const;
+};
+
+
+} // namespace ltps
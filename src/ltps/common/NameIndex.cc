@@ -0,0 +1,292 @@
+#include "ltps/common/NameIndex.h"
+#include "ltps/common/PinyinInitials.h"
+#include <algorithm>
+#include <tuple>
+
+
+namespace ltps {
+
+
+namespace {
+
+using Key = std::uint64_t;
+
+constexpr Key UnigramTag = 1ull << 62;
+
+Key unigram(char32_t c) { return UnigramTag | c; }
+Key bigram(char32_t a, char32_t b) { return static_cast<Key>(a) << 21 | b; }
+
+// 解码 UTF-8，非法字节按 U+FFFD 处理
+std::u32string decodeUtf8(std::string_view str) {
+    std::u32string result;
+    result.reserve(str.size());
+    for (std::size_t i = 0; i < str.size();) {
+        auto     lead = static_cast<unsigned char>(str[i]);
+        int      len  = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        char32_t cp   = len == 1 ? lead : len == 2 ? lead & 0x1F : len == 3 ? lead & 0x0F : lead & 0x07;
+        if (len == 0 || i + len > str.size()) {
+            result.push_back(U'\uFFFD');
+            ++i;
+            continue;
+        }
+        bool valid = true;
+        for (int k = 1; k < len; ++k) {
+            auto cont = static_cast<unsigned char>(str[i + k]);
+            valid     = valid && (cont & 0xC0) == 0x80;
+            cp        = cp << 6 | (cont & 0x3F);
+        }
+        result.push_back(valid ? cp : U'\uFFFD');
+        i += valid ? len : 1;
+    }
+    return result;
+}
+
+char32_t foldCase(char32_t c) {
+    if (c >= 0xFF01 && c <= 0xFF5E) {
+        c -= 0xFEE0; // 全角 ASCII
+    }
+    if ((c >= U'A' && c <= U'Z') || (c >= 0xC0 && c <= 0xDE && c != 0xD7) || (c >= 0x391 && c <= 0x3A9)
+        || (c >= 0x410 && c <= 0x42F)) {
+        return c + 0x20; // ASCII、Latin-1、希腊、西里尔
+    }
+    if (c >= 0x400 && c <= 0x40F) {
+        return c + 0x50;
+    }
+    if (c == 0x178) {
+        return 0xFF; // Ÿ 的小写在 Latin-1 内
+    }
+    if (c >= 0x100 && c <= 0x17E && c != 0x130 && c != 0x131 && c != 0x138 && c != 0x149 && c != 0x178) {
+        // Latin Extended-A 大小写成对排列，0x139~0x148 与 0x179~0x17E 为奇数大写
+        bool oddUpper = (c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17E);
+        if ((c % 2 == 1) == oddUpper) {
+            return c + 1;
+        }
+    }
+    return c;
+}
+
+bool isSeparator(char32_t c) {
+    return c == U' ' || c == U'\t' || c == U'_' || c == U'-' || c == U'.' || c == 0x3000 || c == 0xB7 || c == 0x30FB;
+}
+
+bool isSubsequence(std::u32string const& query, std::u32string const& key) {
+    std::size_t i = 0;
+    for (auto c : key) {
+        if (i < query.size() && query[i] == c) {
+            ++i;
+        }
+    }
+    return i == query.size();
+}
+
+std::optional<NameIndex::MatchKind> classify(std::u32string const& query, std::u32string const& key) {
+    if (key.empty() || query.empty()) {
+        return std::nullopt;
+    }
+    if (key == query) {
+        return NameIndex::MatchKind::Exact;
+    }
+    if (key.starts_with(query)) {
+        return NameIndex::MatchKind::Prefix;
+    }
+    if (key.find(query) != std::u32string::npos) {
+        return NameIndex::MatchKind::Substring;
+    }
+    if (isSubsequence(query, key)) {
+        return NameIndex::MatchKind::Fuzzy;
+    }
+    return std::nullopt;
+}
+
+// 名称与拼音首字母中较好的匹配
+std::optional<NameIndex::MatchKind>
+classify(std::u32string const& query, std::u32string const& key, std::u32string const& initials) {
+    auto byName     = classify(query, key);
+    auto byInitials = classify(query, initials);
+    if (byName && byInitials) {
+        return std::min(*byName, *byInitials);
+    }
+    return byName ? byName : byInitials;
+}
+
+} // namespace
+
+
+NameIndex::NameIndex() = default;
+
+std::u32string NameIndex::normalize(std::string_view name) {
+    auto           decoded = decodeUtf8(name);
+    std::u32string result;
+    result.reserve(decoded.size());
+    for (auto c : decoded) {
+        if (!isSeparator(c)) {
+            result.push_back(foldCase(c));
+        }
+    }
+    return result;
+}
+
+std::u32string NameIndex::toInitials(std::u32string const& normalized) {
+    std::u32string result;
+    bool           converted = false;
+    for (auto c : normalized) {
+        if (auto initial = pinyin::getInitial(c)) {
+            result.push_back(static_cast<char32_t>(initial));
+            converted = true;
+        } else {
+            result.push_back(c);
+        }
+    }
+    return converted ? result : std::u32string{};
+}
+
+std::optional<NameIndex::MatchKind> NameIndex::match(std::u32string const& query, std::string_view name) {
+    auto key = normalize(name);
+    return classify(query, key, toInitials(key));
+}
+
+std::vector<NameIndex::Key> NameIndex::grams(std::u32string const& key, std::u32string const& initials) {
+    std::vector<Key> result;
+    for (auto const* str : {&key, &initials}) {
+        for (std::size_t i = 0; i < str->size(); ++i) {
+            result.push_back(unigram((*str)[i]));
+            if (i + 1 < str->size()) {
+                result.push_back(bigram((*str)[i], (*str)[i + 1]));
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+std::vector<NameIndex::Id> const* NameIndex::postings(Key key) const {
+    auto iter = mPostings.find(key);
+    return iter == mPostings.end() ? nullptr : &iter->second;
+}
+
+void NameIndex::insert(std::string const& name) {
+    if (mIds.contains(name)) {
+        return;
+    }
+
+    Id id;
+    if (!mFreeIds.empty()) {
+        id = mFreeIds.back();
+        mFreeIds.pop_back();
+    } else {
+        id = static_cast<Id>(mEntries.size());
+        mEntries.emplace_back();
+    }
+
+    auto key      = normalize(name);
+    auto initials = toInitials(key);
+    for (auto gram : grams(key, initials)) {
+        mPostings[gram].push_back(id);
+    }
+    mEntries[id] = Entry{name, std::move(key), std::move(initials)};
+    mIds.emplace(name, id);
+}
+
+void NameIndex::erase(std::string const& name) {
+    auto iter = mIds.find(name);
+    if (iter == mIds.end()) {
+        return;
+    }
+    auto id    = iter->second;
+    auto entry = std::move(*mEntries[id]);
+    mIds.erase(iter);
+    mEntries[id].reset();
+    mFreeIds.push_back(id);
+
+    for (auto gram : grams(entry.mKey, entry.mInitials)) {
+        auto posting = mPostings.find(gram);
+        if (posting == mPostings.end()) {
+            continue;
+        }
+        auto& ids = posting->second;
+        if (auto pos = std::find(ids.begin(), ids.end(), id); pos != ids.end()) {
+            *pos = ids.back();
+            ids.pop_back();
+        }
+        if (ids.empty()) {
+            mPostings.erase(posting);
+        }
+    }
+}
+
+void NameIndex::clear() {
+    mEntries.clear();
+    mFreeIds.clear();
+    mIds.clear();
+    mPostings.clear();
+}
+
+std::size_t NameIndex::size() const { return mIds.size(); }
+
+std::vector<std::string> NameIndex::search(std::string_view query, std::size_t limit) const {
+    auto normalized = normalize(query);
+    if (normalized.empty() || limit == 0) {
+        return {};
+    }
+
+    // 完全 / 前缀 / 子串匹配必然包含查询的所有双字，模糊匹配必然包含查询的所有单字；
+    // 只遍历其中最短的倒排表
+    std::vector<Id> const* strong    = nullptr; // 双字候选
+    std::vector<Id> const* weak      = nullptr; // 单字候选
+    bool                   substring = true;    // 所有双字都存在时才可能有子串匹配
+    for (std::size_t i = 0; i < normalized.size(); ++i) {
+        auto ids = postings(unigram(normalized[i]));
+        if (!ids) {
+            return {}; // 有字符不在任何名称中
+        }
+        if (!weak || ids->size() < weak->size()) {
+            weak = ids;
+        }
+        if (i + 1 < normalized.size()) {
+            auto pair = postings(bigram(normalized[i], normalized[i + 1]));
+            if (!pair) {
+                substring = false;
+            } else if (!strong || pair->size() < strong->size()) {
+                strong = pair;
+            }
+        }
+    }
+    if (normalized.size() == 1) {
+        strong = weak; // 单字查询不存在模糊匹配
+    }
+
+    std::vector<std::tuple<MatchKind, std::size_t, Id>> ranked;
+    auto collect = [&](std::vector<Id> const& ids, bool fuzzyOnly) {
+        std::size_t scanned = 0;
+        for (auto id : ids) {
+            if (fuzzyOnly && (ranked.size() >= limit || ++scanned > FuzzyScanLimit)) {
+                break; // 模糊匹配只补足结果数
+            }
+            auto const& entry = *mEntries[id];
+            auto        kind  = classify(normalized, entry.mKey, entry.mInitials);
+            if (kind && (*kind == MatchKind::Fuzzy) == fuzzyOnly) {
+                ranked.emplace_back(*kind, entry.mKey.size(), id);
+            }
+        }
+    };
+    if (substring) {
+        collect(*strong, false);
+    }
+    if (ranked.size() < limit && normalized.size() > 1) {
+        collect(*weak, true);
+    }
+
+    auto count = std::min(limit, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(count), ranked.end());
+
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(mEntries[std::get<2>(ranked[i])]->mName);
+    }
+    return result;
+}
+
+
+} // namespace ltps
@@ -0,0 +1,74 @@
+#pragma once
+#include "ltps/Global.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ltps {
+
+
+/**
+ * @brief 名称搜索索引（传送点 / 家园名）
+ * 名称规范化后（Unicode 大小写折叠、去除空白与分隔符）按单字与双字 n-gram 建立倒排表，
+ * 含汉字的名称额外索引拼音首字母（如 "主城" 可用 "zc" 搜索）。
+ * 增删时增量维护；查询只检查最稀有 n-gram 的倒排表，按 完全匹配 > 前缀 > 子串 > 模糊（子序列）排序。
+ */
+class NameIndex final {
+public:
+    enum class MatchKind { Exact, Prefix, Substring, Fuzzy };
+
+    static inline constexpr std::size_t DefaultLimit   = 50;   // 默认最多返回的结果数
+    static inline constexpr std::size_t FuzzyScanLimit = 4096; // 模糊匹配最多检查的候选数
+
+private:
+    using Id  = std::uint32_t;
+    using Key = std::uint64_t;
+
+    struct Entry {
+        std::string    mName;
+        std::u32string mKey;      // 规范化名称
+        std::u32string mInitials; // 拼音首字母，名称不含汉字时为空
+    };
+
+    std::vector<std::optional<Entry>>        mEntries;
+    std::vector<Id>                          mFreeIds;
+    std::unordered_map<std::string, Id>      mIds;
+    std::unordered_map<Key, std::vector<Id>> mPostings; // n-gram -> 名称
+
+    [[nodiscard]] static std::vector<Key> grams(std::u32string const& key, std::u32string const& initials);
+
+    [[nodiscard]] std::vector<Id> const* postings(Key key) const;
+
+public:
+    TPS_DISALLOW_COPY(NameIndex);
+
+    TPSAPI explicit NameIndex();
+
+    // Unicode 大小写折叠（拉丁、希腊、西里尔、全角字符），去除空白与常见分隔符
+    TPSNDAPI static std::u32string normalize(std::string_view name);
+
+    // 规范化名称中的汉字替换为拼音首字母，不含可转换的汉字时返回空
+    TPSNDAPI static std::u32string toInitials(std::u32string const& normalized);
+
+    // 不使用索引的单个名称匹配（数据量很小时使用），query 为 normalize 的结果
+    TPSNDAPI static std::optional<MatchKind> match(std::u32string const& query, std::string_view name);
+
+    TPSAPI void insert(std::string const& name);
+
+    TPSAPI void erase(std::string const& name);
+
+    TPSAPI void clear();
+
+    TPSNDAPI std::size_t size() const;
+
+    // 按匹配等级、名称长度排序返回名称
+    TPSNDAPI std::vector<std::string> search(std::string_view query, std::size_t limit = DefaultLimit) const;
+};
+
+
+} // namespace ltps
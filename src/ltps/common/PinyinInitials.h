@@ -0,0 +1,15 @@
+#pragma once
+#include "ltps/Global.h"
+
+
+namespace ltps::pinyin {
+
+
+/**
+ * @brief 汉字拼音首字母（小写）
+ * 覆盖 GB2312 一级常用汉字，多音字取 GB2312 排序所用读音；不在表中时返回 0。
+ */
+TPSNDAPI char getInitial(char32_t codePoint);
+
+
+} // namespace ltps::pinyin
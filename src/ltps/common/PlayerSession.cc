@@ -0,0 +1,139 @@
+#include "ltps/common/PlayerSession.h"
+#include "ll/api/event/EventBus.h"
+#include "ll/api/event/player/PlayerDisconnectEvent.h"
+#include "ll/api/event/player/PlayerJoinEvent.h"
+#include "ll/api/service/Bedrock.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/database/StorageManager.h"
+#include "mc/world/actor/player/Player.h"
+#include "mc/world/level/Level.h"
+
+
+namespace ltps {
+
+
+// PlayerSession
+PlayerSession::PlayerSession(Player& player)
+: mRealName(player.getRealName()),
+  mUuid(player.getUuid()),
+  mLocaleCode(player.getLocaleCode()) {
+    if (auto registry = TeleportSystem::getInstance().getStorageManager().getStorage<PlayerRegistry>()) {
+        mPlayerId = registry->registerPlayer(player);
+    }
+
+    auto& table = CooldownTable::getInstance();
+    mCooldownId = table.getOrCreateId(mRealName);
+    table.pin(mCooldownId); // 会话期间行号保持有效
+
+    refreshPermissions();
+    refreshSettings();
+}
+
+PlayerSession::~PlayerSession() { CooldownTable::getInstance().unpin(mCooldownId); }
+
+PlayerId PlayerSession::getPlayerId() const { return mPlayerId; }
+
+RealName const& PlayerSession::getRealName() const { return mRealName; }
+
+mce::UUID const& PlayerSession::getUuid() const { return mUuid; }
+
+std::string const& PlayerSession::getLocaleCode() const { return mLocaleCode; }
+
+setting::SettingData const& PlayerSession::getSettings() const { return mSettings; }
+
+CooldownTable::Id PlayerSession::getCooldownId() const { return mCooldownId; }
+
+bool PlayerSession::hasPermission(PermissionStorage::Permission permission, bool whenAbsent) const {
+    if (!mPermissionMask) {
+        return whenAbsent;
+    }
+    return (*mPermissionMask & static_cast<int>(permission)) != 0;
+}
+
+void PlayerSession::refreshPermissions() {
+    if (auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<PermissionStorage>()) {
+        mPermissionMask = storage->getPermissionMask(mPlayerId);
+    } else {
+        mPermissionMask.reset();
+    }
+}
+
+void PlayerSession::refreshSettings() {
+    auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<setting::SettingStorage>();
+    if (!storage) {
+        return;
+    }
+    if (auto data = storage->getSettingData(mPlayerId)) {
+        mSettings = *data;
+    } else {
+        mSettings = setting::SettingData{}; // 新玩家，与 SettingStorage::initPlayerSetting 一致
+    }
+}
+
+
+// SessionManager
+SessionManager::SessionManager() = default;
+
+SessionManager::~SessionManager() { detach(); }
+
+void SessionManager::attach() {
+    auto& bus = ll::event::EventBus::getInstance();
+
+    mListeners.emplace_back(bus.emplaceListener<ll::event::PlayerJoinEvent>([this](ll::event::PlayerJoinEvent& ev) {
+        (void)getSession(ev.self());
+    }));
+
+    mListeners.emplace_back(
+        bus.emplaceListener<ll::event::PlayerDisconnectEvent>([this](ll::event::PlayerDisconnectEvent& ev) {
+            mSessions.erase(ev.self().getUuid());
+        })
+    );
+
+    if (auto level = ll::service::getLevel()) {
+        level->forEachPlayer([this](Player& player) {
+            (void)getSession(player);
+            return true;
+        });
+    }
+}
+
+void SessionManager::detach() {
+    auto& bus = ll::event::EventBus::getInstance();
+    for (auto& listener : mListeners) {
+        bus.removeListener(listener);
+    }
+    mListeners.clear();
+    mSessions.clear();
+}
+
+PlayerSession& SessionManager::getSession(Player& player) {
+    auto uuid = player.getUuid();
+    if (auto iter = mSessions.find(uuid); iter != mSessions.end()) {
+        return *iter->second;
+    }
+    return *mSessions.emplace(uuid, std::make_unique<PlayerSession>(player)).first->second;
+}
+
+PlayerSession* SessionManager::findSession(mce::UUID const& uuid) const {
+    auto iter = mSessions.find(uuid);
+    return iter == mSessions.end() ? nullptr : iter->second.get();
+}
+
+void SessionManager::refreshPermissions(RealName const& realName) {
+    for (auto& [_, session] : mSessions) {
+        if (realName.empty() || session->getRealName() == realName) {
+            session->refreshPermissions();
+        }
+    }
+}
+
+void SessionManager::refreshSettings(RealName const& realName) {
+    for (auto& [_, session] : mSessions) {
+        if (session->getRealName() == realName) {
+            session->refreshSettings();
+        }
+    }
+}
+
+
+} // namespace ltps
@@ -0,0 +1,90 @@
+#pragma once
+#include "ll/api/event/ListenerBase.h"
+#include "ltps/Global.h"
+#include "ltps/common/Cooldown.h"
+#include "ltps/database/PermissionStorage.h"
+#include "ltps/database/PlayerRegistry.h"
+#include "ltps/modules/setting/SettingStorage.h"
+#include "mc/platform/UUID.h"
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+class Player;
+
+namespace ltps {
+
+
+/**
+ * @brief 玩家会话（进服创建，退出销毁）
+ * 缓存玩家 Id、玩家名、UUID、语言、有效权限掩码、设置与冷却表行号，
+ * 热路径直接读取会话，避免每次请求重复拷贝字符串并按玩家名查询多个哈希表。
+ * 权限与设置修改时由对应 Storage 通知 SessionManager 刷新。
+ */
+class PlayerSession final {
+    PlayerId             mPlayerId{InvalidPlayerId};
+    RealName             mRealName;
+    mce::UUID            mUuid;
+    std::string          mLocaleCode;
+    std::optional<int>   mPermissionMask;    // 包含默认权限，没有 PermissionStorage 时为空
+    setting::SettingData mSettings{};
+    CooldownTable::Id    mCooldownId{CooldownTable::InvalidId};
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(PlayerSession);
+
+    TPSAPI explicit PlayerSession(Player& player);
+    TPSAPI ~PlayerSession();
+
+    TPSNDAPI PlayerId getPlayerId() const;
+
+    TPSNDAPI RealName const& getRealName() const;
+
+    TPSNDAPI mce::UUID const& getUuid() const;
+
+    TPSNDAPI std::string const& getLocaleCode() const;
+
+    TPSNDAPI setting::SettingData const& getSettings() const;
+
+    TPSNDAPI CooldownTable::Id getCooldownId() const;
+
+    // whenAbsent: 没有 PermissionStorage 时的结果
+    TPSNDAPI bool hasPermission(PermissionStorage::Permission permission, bool whenAbsent = false) const;
+
+    TPSAPI void refreshPermissions();
+
+    TPSAPI void refreshSettings();
+};
+
+
+class SessionManager final {
+    std::unordered_map<mce::UUID, std::unique_ptr<PlayerSession>> mSessions;
+    std::vector<ll::event::ListenerPtr>                           mListeners;
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(SessionManager);
+
+    TPSAPI explicit SessionManager();
+    TPSAPI ~SessionManager();
+
+    // 注册进服 / 退出监听，并为已在线玩家创建会话（热重载）
+    TPSAPI void attach();
+
+    TPSAPI void detach();
+
+    // 获取玩家会话，不存在时创建
+    TPSNDAPI PlayerSession& getSession(Player& player);
+
+    TPSNDAPI PlayerSession* findSession(mce::UUID const& uuid) const;
+
+    // 刷新指定玩家的权限缓存，realName 为空时刷新所有会话（默认权限变更）
+    TPSAPI void refreshPermissions(RealName const& realName = {});
+
+    TPSAPI void refreshSettings(RealName const& realName);
+};
+
+
+} // namespace ltps
@@ -0,0 +1,77 @@
+#include "ltps/common/RateLimiter.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
+#include "ltps/utils/McUtils.h"
+#include <algorithm>
+
+
+namespace ltps {
+
+
+RateLimiter::RateLimiter() = default;
+
+RateLimiter& RateLimiter::getInstance() {
+    static RateLimiter instance;
+    return instance;
+}
+
+RateLimiter::Config& RateLimiter::getConfig() const { return config::getConfig().rateLimit; }
+
+void RateLimiter::_refill(Bucket& bucket, Clock::time_point now) const {
+    auto& cfg     = getConfig();
+    auto  elapsed = std::chrono::duration<double>(now - bucket.lastRefill).count();
+
+    bucket.tokens     = std::min(static_cast<double>(cfg.capacity), bucket.tokens + elapsed * cfg.refillRate);
+    bucket.lastRefill = now;
+}
+
+void RateLimiter::_purgeIdleBuckets(Clock::time_point now) {
+    auto capacity = static_cast<double>(getConfig().capacity);
+    std::erase_if(mBuckets, [&](auto& pair) {
+        _refill(pair.second, now);
+        return pair.second.tokens >= capacity; // 令牌已补满，与新建令牌桶等价
+    });
+}
+
+bool RateLimiter::tryAcquire(RealName const& realName, double cost) {
+    auto& cfg = getConfig();
+    if (!cfg.enabled) {
+        return true;
+    }
+
+    auto now = Clock::now();
+    if (++mAcquireCounter >= PurgeInterval) {
+        mAcquireCounter = 0;
+        _purgeIdleBuckets(now);
+    }
+
+    auto [iter, inserted] = mBuckets.try_emplace(realName, Bucket{static_cast<double>(cfg.capacity), now});
+    auto& bucket          = iter->second;
+    if (!inserted) {
+        _refill(bucket, now);
+    }
+
+    if (bucket.tokens < cost) {
+        return false;
+    }
+    bucket.tokens -= cost;
+    return true;
+}
+
+bool RateLimiter::tryAcquire(Player& player, double cost) {
+    return tryAcquire(TeleportSystem::getInstance().getSessionManager().getSession(player).getRealName(), cost);
+}
+
+void RateLimiter::reset(RealName const& realName) { mBuckets.erase(realName); }
+
+void RateLimiter::sendRateLimitedMessage(Player& player, std::string const& localeCode) const {
+    mc_utils::sendText<mc_utils::Error>(player, "操作过于频繁，请稍后再试"_trl(localeCode));
+}
+
+void RateLimiter::sendRateLimitedMessage(Player& player) const {
+    auto& session = TeleportSystem::getInstance().getSessionManager().getSession(player);
+    sendRateLimitedMessage(player, session.getLocaleCode());
+}
+
+
+} // namespace ltps
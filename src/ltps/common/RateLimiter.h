@@ -0,0 +1,69 @@
+#pragma once
+#include "ltps/Global.h"
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+
+class Player;
+
+namespace ltps {
+
+
+/**
+ * @brief 全局令牌桶限流器（按玩家）
+ * 所有模块的请求入口在执行价格计算、事件发布等操作之前先调用 tryAcquire，
+ * 令牌不足时直接拒绝，避免恶意客户端刷请求 / 狂点表单按钮。
+ * 令牌桶满的玩家等价于不存在，会被摊还清理，表大小只与活跃玩家数相关。
+ */
+class RateLimiter final {
+public:
+    struct Config {
+        bool   enabled    = true;
+        int    capacity   = 5;   // 令牌桶容量（允许的突发请求数）
+        double refillRate = 1.0; // 每秒恢复的令牌数
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Bucket {
+        double            tokens;
+        Clock::time_point lastRefill;
+    };
+
+    std::unordered_map<RealName, Bucket> mBuckets;
+    std::size_t                          mAcquireCounter{0};
+
+    static inline constexpr std::size_t PurgeInterval = 256; // 每 N 次请求清理一次空闲令牌桶
+
+    explicit RateLimiter();
+
+    void _refill(Bucket& bucket, Clock::time_point now) const;
+    void _purgeIdleBuckets(Clock::time_point now);
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(RateLimiter);
+
+    TPSNDAPI static RateLimiter& getInstance();
+
+    TPSNDAPI Config& getConfig() const;
+
+    // 尝试消耗令牌，返回 false 表示请求被限流
+    TPSNDAPI bool tryAcquire(RealName const& realName, double cost = 1.0);
+
+    // 按玩家会话中的玩家名消耗令牌
+    TPSNDAPI bool tryAcquire(Player& player, double cost = 1.0);
+
+    // 重置玩家令牌桶
+    TPSAPI void reset(RealName const& realName);
+
+    TPSAPI void sendRateLimitedMessage(Player& player, std::string const& localeCode) const;
+
+    // 使用玩家会话中的语言
+    TPSAPI void sendRateLimitedMessage(Player& player) const;
+};
+
+
+} // namespace ltps
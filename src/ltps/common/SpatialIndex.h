@@ -0,0 +1,245 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace ltps {
+
+
+/**
+ * @brief 按维度划分的均匀网格空间索引（传送点 / 家园坐标）
+ * 增删改为 O(1)；最近邻查询由查询点所在网格向外逐环扩展，找到 k 个且下一环不可能更近时停止；
+ * 区域查询只访问与区域相交的网格。需要访问的网格数超过维度内记录数时改为直接遍历该维度。
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class SpatialIndex {
+public:
+    struct Point {
+        int   dimId;
+        float x, y, z;
+    };
+
+    struct Neighbor {
+        Key   key;
+        float distance;
+    };
+
+private:
+    using CellKey = std::uint64_t;
+
+    struct Dimension {
+        std::unordered_map<CellKey, std::vector<Key>> mCells;
+        std::size_t                                   mCount{0};
+    };
+
+    int                                  mCellSize;
+    std::unordered_map<Key, Point, Hash> mPoints;
+    std::unordered_map<int, Dimension>   mDimensions;
+
+    [[nodiscard]] int toCell(float v) const { return static_cast<int>(std::floor(v / static_cast<float>(mCellSize))); }
+
+    [[nodiscard]] static CellKey toCellKey(int cx, int cz) {
+        return static_cast<CellKey>(static_cast<std::uint32_t>(cx)) << 32 | static_cast<std::uint32_t>(cz);
+    }
+
+    [[nodiscard]] CellKey cellOf(Point const& p) const { return toCellKey(toCell(p.x), toCell(p.z)); }
+
+    [[nodiscard]] static float distance(Point const& a, float x, float y, float z) {
+        auto dx = a.x - x, dy = a.y - y, dz = a.z - z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    void _remove(Key const& key, Point const& point) {
+        auto dim = mDimensions.find(point.dimId);
+        if (dim == mDimensions.end()) {
+            return;
+        }
+        auto cell = dim->second.mCells.find(cellOf(point));
+        if (cell != dim->second.mCells.end()) {
+            auto& keys = cell->second;
+            if (auto iter = std::find(keys.begin(), keys.end(), key); iter != keys.end()) {
+                *iter = std::move(keys.back());
+                keys.pop_back();
+                dim->second.mCount--;
+            }
+            if (keys.empty()) {
+                dim->second.mCells.erase(cell);
+            }
+        }
+        if (dim->second.mCount == 0) {
+            mDimensions.erase(dim);
+        }
+    }
+
+public:
+    explicit SpatialIndex(int cellSize = 64) : mCellSize(std::max(cellSize, 1)) {}
+
+    // 插入或移动
+    void insert(Key const& key, Point const& point) {
+        if (auto iter = mPoints.find(key); iter != mPoints.end()) {
+            _remove(key, iter->second);
+            iter->second = point;
+        } else {
+            mPoints.emplace(key, point);
+        }
+        auto& dim = mDimensions[point.dimId];
+        dim.mCells[cellOf(point)].push_back(key);
+        dim.mCount++;
+    }
+
+    bool erase(Key const& key) {
+        auto iter = mPoints.find(key);
+        if (iter == mPoints.end()) {
+            return false;
+        }
+        _remove(key, iter->second);
+        mPoints.erase(iter);
+        return true;
+    }
+
+    void clear() {
+        mPoints.clear();
+        mDimensions.clear();
+    }
+
+    [[nodiscard]] std::size_t size() const { return mPoints.size(); }
+
+    [[nodiscard]] Point const* find(Key const& key) const {
+        auto iter = mPoints.find(key);
+        return iter == mPoints.end() ? nullptr : &iter->second;
+    }
+
+    /**
+     * @brief 最近的 k 个点（三维距离），按距离升序
+     * @param maxDistance 只返回此距离内的点
+     */
+    [[nodiscard]] std::vector<Neighbor> nearest(
+        int         dimId,
+        float       x,
+        float       y,
+        float       z,
+        std::size_t k,
+        float       maxDistance = std::numeric_limits<float>::infinity()
+    ) const {
+        auto dimIter = mDimensions.find(dimId);
+        if (k == 0 || dimIter == mDimensions.end()) {
+            return {};
+        }
+        auto const& dim = dimIter->second;
+
+        auto cmp      = [](Neighbor const& a, Neighbor const& b) { return a.distance < b.distance; };
+        auto heap     = std::priority_queue<Neighbor, std::vector<Neighbor>, decltype(cmp)>{cmp}; // 大顶堆
+        auto consider = [&](Key const& key) {
+            auto d = distance(mPoints.at(key), x, y, z);
+            if (d > maxDistance) {
+                return;
+            }
+            if (heap.size() < k) {
+                heap.push({key, d});
+            } else if (d < heap.top().distance) {
+                heap.pop();
+                heap.push({key, d});
+            }
+        };
+
+        auto const  cx         = toCell(x);
+        auto const  cz         = toCell(z);
+        std::size_t visits     = 0;
+        bool        exhaustive = false;
+        auto        visit      = [&](int dx, int dz) {
+            if (exhaustive || ++visits > dim.mCells.size()) {
+                exhaustive = true; // 需要访问的网格比已有网格还多，直接遍历
+                return;
+            }
+            if (auto cell = dim.mCells.find(toCellKey(cx + dx, cz + dz)); cell != dim.mCells.end()) {
+                for (auto const& key : cell->second) {
+                    consider(key);
+                }
+            }
+        };
+        for (int r = 0;; ++r) {
+            // 访问切比雪夫距离为 r 的一环网格
+            if (r == 0) {
+                visit(0, 0);
+            }
+            for (int i = -r; i <= r && r > 0; ++i) {
+                visit(i, -r);
+                visit(i, r);
+            }
+            for (int i = -r + 1; i <= r - 1; ++i) {
+                visit(-r, i);
+                visit(r, i);
+            }
+            if (exhaustive) {
+                heap = decltype(heap){cmp};
+                for (auto const& [_, keys] : dim.mCells) {
+                    for (auto const& key : keys) {
+                        consider(key);
+                    }
+                }
+                break;
+            }
+            // 下一环内的点距离至少为 r * cellSize
+            auto const bound = static_cast<float>(r) * static_cast<float>(mCellSize);
+            if ((heap.size() == k && heap.top().distance <= bound) || bound > maxDistance) {
+                break;
+            }
+        }
+
+        std::vector<Neighbor> result(heap.size());
+        for (auto i = result.size(); i > 0; --i) {
+            result[i - 1] = heap.top();
+            heap.pop();
+        }
+        return result;
+    }
+
+    // 水平范围 [minX, maxX] x [minZ, maxZ] 内的点
+    [[nodiscard]] std::vector<Key> within(int dimId, float minX, float minZ, float maxX, float maxZ) const {
+        auto dimIter = mDimensions.find(dimId);
+        if (dimIter == mDimensions.end()) {
+            return {};
+        }
+        if (minX > maxX) std::swap(minX, maxX);
+        if (minZ > maxZ) std::swap(minZ, maxZ);
+
+        std::vector<Key> result;
+        auto             collect = [&](std::vector<Key> const& keys) {
+            for (auto const& key : keys) {
+                auto const& p = mPoints.at(key);
+                if (p.x >= minX && p.x <= maxX && p.z >= minZ && p.z <= maxZ) {
+                    result.push_back(key);
+                }
+            }
+        };
+
+        auto const& dim    = dimIter->second;
+        auto const  cells  = (static_cast<double>(toCell(maxX)) - toCell(minX) + 1)
+                         * (static_cast<double>(toCell(maxZ)) - toCell(minZ) + 1);
+        if (cells > static_cast<double>(dim.mCells.size())) {
+            for (auto const& [_, keys] : dim.mCells) {
+                collect(keys);
+            }
+            return result;
+        }
+        for (int cx = toCell(minX); cx <= toCell(maxX); ++cx) {
+            for (int cz = toCell(minZ); cz <= toCell(maxZ); ++cz) {
+                if (auto cell = dim.mCells.find(toCellKey(cx, cz)); cell != dim.mCells.end()) {
+                    collect(cell->second);
+                }
+            }
+        }
+        return result;
+    }
+};
+
+
+} // namespace ltps
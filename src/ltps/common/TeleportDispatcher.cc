@@ -0,0 +1,173 @@
+#include "ltps/common/TeleportDispatcher.h"
+#include "ll/api/chrono/GameChrono.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
+#include "ltps/common/EconomySystem.h"
+#include "ltps/utils/McUtils.h"
+#include "mc/world/actor/player/Player.h"
+#include <algorithm>
+#include <ll/api/coro/CoroTask.h>
+#include <utility>
+
+
+namespace ltps {
+
+
+TeleportDispatcher::TeleportDispatcher(ll::thread::ServerThreadExecutor const& executor) {
+    mInterruptableSleep = std::make_shared<ll::coro::InterruptableSleep>();
+    mAbortFlag          = std::make_shared<std::atomic_bool>(false);
+
+    ll::coro::keepThis([this, sleep = mInterruptableSleep, abortFlag = mAbortFlag]() -> ll::coro::CoroTask<> {
+        while (!abortFlag->load()) {
+            if (mMetrics.queued == 0 && mUsedThisTick == 0) {
+                co_await sleep->sleepFor(ll::chrono::ticks{IdleSleepTicks});
+                if (abortFlag->load()) break;
+            }
+            co_await ll::chrono::ticks(1); // 唤醒后等到下一 tick 再重置预算
+            if (abortFlag->load()) break;
+            try {
+                _tick();
+            } catch (...) {
+                TeleportSystem::getInstance().getSelf().getLogger().error(
+                    "An exception occurred while dispatching teleports"
+                );
+            }
+        }
+        co_return;
+    }).launch(executor.getDefault());
+}
+
+TeleportDispatcher::~TeleportDispatcher() {
+    mAbortFlag->store(true);
+    mInterruptableSleep->interrupt(true);
+    clear();
+}
+
+int TeleportDispatcher::getBudget() {
+    auto const& cfg = getConfig().teleportDispatch;
+    return cfg.enable ? std::max(cfg.perTickBudget, 1) : -1; // -1: 不限制
+}
+
+bool TeleportDispatcher::dispatch(Player& player, int targetDimId, Action action, DropCallback onDropped) {
+    auto budget = getBudget();
+    if (budget < 0 || (mMetrics.queued == 0 && mUsedThisTick < budget)) {
+        bool const wasIdle = mUsedThisTick == 0;
+        mUsedThisTick++;
+        mMetrics.immediate++;
+        if (wasIdle) {
+            mInterruptableSleep->interrupt(); // 下一 tick 重置预算
+        }
+        _run(player, action);
+        return true;
+    }
+
+    mQueues[targetDimId].push_back({player.getWeakEntity(), std::move(action), std::move(onDropped), Clock::now()});
+    mMetrics.queued++;
+    mMetrics.peakQueued = std::max(mMetrics.peakQueued, mMetrics.queued);
+    mInterruptableSleep->interrupt();
+
+    auto& session = TeleportSystem::getInstance().getSessionManager().getSession(player);
+    mc_utils::sendText(
+        player,
+        "传送请求较多，已加入队列，前方还有 {0} 个传送"_trl(session.getLocaleCode(), mMetrics.queued - 1)
+    );
+    return false;
+}
+
+void TeleportDispatcher::_tick() {
+    mUsedThisTick = 0;
+
+    auto budget = getBudget();
+    while (mMetrics.queued > 0 && (budget < 0 || mUsedThisTick < budget)) {
+        if (!_runNext()) {
+            break;
+        }
+    }
+}
+
+bool TeleportDispatcher::_runNext() {
+    if (mQueues.empty()) {
+        return false;
+    }
+
+    // 从上一次出队维度的下一个维度开始轮转
+    auto iter = mLastDim ? mQueues.upper_bound(*mLastDim) : mQueues.begin();
+    if (iter == mQueues.end()) {
+        iter = mQueues.begin();
+    }
+    mLastDim = iter->first;
+
+    auto job = std::move(iter->second.front());
+    iter->second.pop_front();
+    if (iter->second.empty()) {
+        mQueues.erase(iter);
+    }
+    mMetrics.queued--;
+
+    auto player = job.mPlayer.tryUnwrap<Player>().as_ptr();
+    if (!player) {
+        _drop(job);
+        return true; // 离线玩家不占用预算
+    }
+
+    auto wait = Clock::now() - job.mEnqueuedAt;
+    mMetrics.deferred++;
+    mMetrics.totalWait += wait;
+    mMetrics.maxWait    = std::max(mMetrics.maxWait, wait);
+    mUsedThisTick++;
+    _run(*player, job.mAction);
+    return true;
+}
+
+void TeleportDispatcher::_run(Player& player, Action const& action) {
+    try {
+        action(player);
+    } catch (...) {
+        TeleportSystem::getInstance().getSelf().getLogger().error("An exception occurred while teleporting a player");
+    }
+}
+
+void TeleportDispatcher::_drop(Job& job) {
+    mMetrics.dropped++;
+    if (!job.mOnDropped) {
+        return;
+    }
+    try {
+        job.mOnDropped();
+    } catch (...) {
+        TeleportSystem::getInstance().getSelf().getLogger().error("An exception occurred while dropping a teleport");
+    }
+}
+
+TeleportDispatcher::DropCallback
+TeleportDispatcher::makeRefund(Player& player, long long price, std::optional<CooldownTable::Column> cooldown) {
+    auto& session = TeleportSystem::getInstance().getSessionManager().getSession(player);
+    return [uuid = session.getUuid(), realName = session.getRealName(), price, cooldown]() {
+        if (price > 0 && !EconomySystemManager::getInstance()->add(uuid, price)) {
+            TeleportSystem::getInstance().getSelf().getLogger().warn(
+                "Could not refund {} to {} for a dropped teleport",
+                price,
+                realName
+            );
+        }
+        if (cooldown) {
+            auto& table = CooldownTable::getInstance();
+            table.setCooldown(table.findId(realName), *cooldown, 0);
+        }
+    };
+}
+
+TeleportDispatcher::Metrics const& TeleportDispatcher::getMetrics() const { return mMetrics; }
+
+void TeleportDispatcher::clear() {
+    auto queues     = std::exchange(mQueues, {});
+    mMetrics.queued = 0;
+    for (auto& [_, jobs] : queues) {
+        for (auto& job : jobs) {
+            _drop(job);
+        }
+    }
+}
+
+
+} // namespace ltps
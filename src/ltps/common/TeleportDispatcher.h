@@ -0,0 +1,98 @@
+#pragma once
+#include "ltps/Global.h"
+#include "ltps/common/Cooldown.h"
+#include "mc/deps/ecs/WeakEntityRef.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <ll/api/coro/InterruptableSleep.h>
+#include <ll/api/thread/ServerThreadExecutor.h>
+#include <map>
+#include <memory>
+#include <optional>
+
+
+class Player;
+
+namespace ltps {
+
+
+/**
+ * @brief 传送分发队列（所有模块共用）
+ * 每 tick 最多执行 perTickBudget 次传送，超出的请求按目标维度排队，各维度轮流出队，
+ * 预算未用完且没有排队请求时立即执行，与直接传送一致。
+ * 调用方在 teleporting 事件之后提交，在 action 中传送并发布 teleported 事件，事件顺序不变。
+ * 排队的传送在玩家离线或队列被清空时丢弃并调用 onDropped（退还费用、结束请求等）。
+ */
+class TeleportDispatcher final {
+public:
+    using Action       = std::function<void(Player& player)>; // 出队时玩家已离线则不调用
+    using DropCallback = std::function<void()>;               // 排队的传送被丢弃时调用
+    using Clock  = std::chrono::steady_clock;
+
+    struct Metrics {
+        std::size_t     queued{0};     // 当前排队数
+        std::size_t     peakQueued{0}; // 排队峰值
+        std::size_t     immediate{0};  // 立即执行
+        std::size_t     deferred{0};   // 排队后执行
+        std::size_t     dropped{0};    // 玩家离线或队列清空而丢弃
+        Clock::duration totalWait{};   // 排队后执行的累计等待
+        Clock::duration maxWait{};     // 最长等待
+    };
+
+private:
+    struct Job {
+        WeakRef<EntityContext> mPlayer;
+        Action                 mAction;
+        DropCallback           mOnDropped;
+        Clock::time_point      mEnqueuedAt;
+    };
+
+    static inline constexpr int IdleSleepTicks = 1200; // 空闲休眠时长，有传送时提前唤醒
+
+    std::map<int, std::deque<Job>>                mQueues;          // 目标维度 -> 排队的传送
+    std::optional<int>                            mLastDim;         // 上一次出队的维度（轮转起点）
+    int                                           mUsedThisTick{0}; // 本 tick 已执行的传送数
+    Metrics                                       mMetrics;
+    std::shared_ptr<ll::coro::InterruptableSleep> mInterruptableSleep{nullptr};
+    std::shared_ptr<std::atomic_bool>             mAbortFlag{nullptr};
+
+    [[nodiscard]] static int getBudget();
+
+    void _tick();
+    bool _runNext(); // 按维度轮转执行一个排队的传送，没有排队时返回 false
+    void _run(Player& player, Action const& action);
+    void _drop(Job& job);
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(TeleportDispatcher);
+
+    TPSAPI explicit TeleportDispatcher(ll::thread::ServerThreadExecutor const& executor);
+    TPSAPI ~TeleportDispatcher();
+
+    /**
+     * @brief 提交传送
+     * @param targetDimId 目标维度（用于按维度公平出队）
+     * @param action 执行传送，调用时玩家一定在线
+     * @param onDropped 排队期间玩家离线或队列被清空时调用，立即执行时不调用
+     * @return true 表示已立即执行，排队时会提示玩家
+     */
+    TPSAPI bool dispatch(Player& player, int targetDimId, Action action, DropCallback onDropped = {});
+
+    /**
+     * @brief 丢弃时退还费用并清除冷却
+     * 费用与冷却在 teleporting 事件中扣除，传送被丢弃时按玩家 UUID 退还（玩家可能已离线）。
+     */
+    TPSNDAPI static DropCallback
+    makeRefund(Player& player, long long price, std::optional<CooldownTable::Column> cooldown = std::nullopt);
+
+    TPSNDAPI Metrics const& getMetrics() const;
+
+    // 丢弃所有排队的传送（调用 onDropped）
+    TPSAPI void clear();
+};
+
+
+} // namespace ltps
@@ -1,5 +1,6 @@
 #include "ltps/database/IStorage.h"
 #include "ltps/TeleportSystem.h"
+#include "ltps/database/PlayerRegistry.h"
 #include "ltps/database/StorageManager.h"
 
 namespace ltps {
@@ -9,5 +10,9 @@ ll::data::KeyValueDB& IStorage::getDatabase() const {
     return *TeleportSystem::getInstance().getStorageManager().mDatabase;
 }
 
+PlayerRegistry& IStorage::getPlayerRegistry() const {
+    return *TeleportSystem::getInstance().getStorageManager().getStorage<PlayerRegistry>();
+}
+
 
 } // namespace ltps
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 namespace ltps {
 
+class PlayerRegistry;
 
 class IStorage {
     friend class StorageManager;
@@ -12,6 +13,8 @@ class IStorage {
 protected:
     TPSNDAPI inline ll::data::KeyValueDB& getDatabase() const;
 
+    TPSNDAPI PlayerRegistry& getPlayerRegistry() const;
+
 public:
     virtual ~IStorage() = default;
 
@@ -17,6 +17,14 @@ namespace ltps {
 
 PermissionStorage::PermissionStorage() = default;
 
+template <class J>
+void PermissionStorage::_fromJson(J& json) {
+    mData.mDefaultPerms = json.value("mDefaultPerms", 0);
+    if (json.contains("mPlayerPerms")) {
+        mData.mPlayerPerms.fromJson(getPlayerRegistry(), json["mPlayerPerms"]);
+    }
+}
+
 void PermissionStorage::load() {
     if (_hasLegacyPermissionFile()) {
         _tryLoadLegacyPermissionFile(); // 加载旧版权限文件
@@ -41,7 +49,7 @@ void PermissionStorage::load() {
     try {
         auto json = nlohmann::json::parse(rawJson.value());
 
-        json_utils::json2structTryPatch(mData, json);
+        _fromJson(json);
 
         TeleportSystem::getInstance().getSelf().getLogger().info(
             "Loaded permissions, {} entries",
@@ -56,7 +64,10 @@ void PermissionStorage::unload() { writeBack(); }
 
 void PermissionStorage::writeBack() {
     auto& db   = getDatabase();
-    auto  json = json_utils::struct2json(mData);
+    auto  json = nlohmann::ordered_json{
+        {"mDefaultPerms", mData.mDefaultPerms                           },
+        {"mPlayerPerms",  mData.mPlayerPerms.toJson(getPlayerRegistry())}
+    };
     db.set(STORAGE_KEY, json.dump());
 }
 
@@ -80,7 +91,7 @@ void PermissionStorage::_tryLoadLegacyPermissionFile() {
     try {
         auto json = nlohmann::json::parse(content.value());
 
-        json_utils::json2structTryPatch(mData, json);
+        _fromJson(json);
 
         TeleportSystem::getInstance().getSelf().getLogger().info(
             "Loaded legacy permissions, {} entries",
@@ -106,24 +117,36 @@ bool PermissionStorage::hasDefaultPermission(Permission permission) const {
 
 bool PermissionStorage::hasPermission(RealName const& realName, Permission permission, bool includeDefault) const {
     if (includeDefault && hasDefaultPermission(permission)) return true;
-    if (!mData.mPlayerPerms.contains(realName)) return false;
-    return (mData.mPlayerPerms.at(realName) & static_cast<int>(permission)) != 0;
+    auto perms = mData.mPlayerPerms.find(getPlayerRegistry().find(realName));
+    return perms && (*perms & static_cast<int>(permission)) != 0;
+}
+
+int PermissionStorage::getPermissionMask(RealName const& realName, bool includeDefault) const {
+    return getPermissionMask(getPlayerRegistry().find(realName), includeDefault);
+}
+
+int PermissionStorage::getPermissionMask(PlayerId id, bool includeDefault) const {
+    int mask = includeDefault ? mData.mDefaultPerms : 0;
+    if (auto perms = mData.mPlayerPerms.find(id)) mask |= *perms;
+    return mask;
 }
 
 Result<void> PermissionStorage::grantPermission(RealName const& realName, Permission permission) {
     if (hasPermission(realName, permission, false)) return std::unexpected("Permission already granted");
-    mData.mPlayerPerms[realName] |= static_cast<int>(permission);
+    mData.mPlayerPerms[getPlayerRegistry().getOrCreate(realName)] |= static_cast<int>(permission);
+    TeleportSystem::getInstance().getSessionManager().refreshPermissions(realName);
     return {};
 }
 
 Result<void> PermissionStorage::revokePermission(RealName const& realName, Permission permission) {
     if (!hasPermission(realName, permission, false)) return std::unexpected("Permission not granted");
-    mData.mPlayerPerms[realName] &= ~static_cast<int>(permission);
+    mData.mPlayerPerms[getPlayerRegistry().getOrCreate(realName)] &= ~static_cast<int>(permission);
+    TeleportSystem::getInstance().getSessionManager().refreshPermissions(realName);
     return {};
 }
 
 std::vector<PermissionStorage::Permission> PermissionStorage::getPermissions(RealName const& realName) const {
-    if (!mData.mPlayerPerms.contains(realName)) return {};
+    if (!mData.mPlayerPerms.contains(getPlayerRegistry().find(realName))) return {};
     std::vector<Permission> result;
     for (auto const& p : magic_enum::enum_values<Permission>()) {
         if (hasPermission(realName, p, false)) result.push_back(p);
@@ -135,12 +158,14 @@ std::vector<PermissionStorage::Permission> PermissionStorage::getPermissions(Rea
 Result<void> PermissionStorage::grantDefaultPermission(Permission permission) {
     if (hasDefaultPermission(permission)) return std::unexpected("Permission already granted");
     mData.mDefaultPerms |= static_cast<int>(permission);
+    TeleportSystem::getInstance().getSessionManager().refreshPermissions();
     return {};
 }
 
 Result<void> PermissionStorage::revokeDefaultPermission(Permission permission) {
     if (!hasDefaultPermission(permission)) return std::unexpected("Permission not granted");
     mData.mDefaultPerms &= ~static_cast<int>(permission);
+    TeleportSystem::getInstance().getSessionManager().refreshPermissions();
     return {};
 }
 
@@ -154,7 +179,7 @@ std::vector<PermissionStorage::Permission> PermissionStorage::getDefaultPermissi
 
 Result<std::pair<std::vector<PermissionStorage::Permission>, std::vector<PermissionStorage::Permission>>>
 PermissionStorage::tracePermissions(RealName const& realName) const {
-    if (!mData.mPlayerPerms.contains(realName)) {
+    if (!mData.mPlayerPerms.contains(getPlayerRegistry().find(realName))) {
         return std::unexpected("Player not found");
     }
     auto defaultPerms = getDefaultPermissions();
@@ -1,6 +1,7 @@
 #pragma once
 #include "ltps/Global.h"
 #include "ltps/database/IStorage.h"
+#include "ltps/database/PlayerTable.h"
 #include <optional>
 #include <utility>
 #include <vector>
@@ -26,10 +27,13 @@ class PermissionStorage final : public IStorage {
 
 private:
     struct {
-        int                               mDefaultPerms{0}; // 默认权限
-        std::unordered_map<RealName, int> mPlayerPerms;     // 玩家权限
+        int              mDefaultPerms{0}; // 默认权限
+        PlayerTable<int> mPlayerPerms;     // 玩家权限 (PlayerId -> 权限掩码)
     } mData;
 
+    template <class J>
+    void _fromJson(J& json);
+
 public:
     enum class Permission : int {
         None          = 0,      // 无权限
@@ -38,6 +42,7 @@ class PermissionStorage final : public IStorage {
         EditWarp      = 1 << 2, // 编辑传送点
         ManagerPanel  = 1 << 3, // 管理面板
         UnlimitedHome = 1 << 4, // 无限传送点
+        BroadcastTpa  = 1 << 5, // 批量 Tpa 请求（召集）
     };
 
     /**
@@ -51,6 +56,13 @@ class PermissionStorage final : public IStorage {
      */
     TPSNDAPI bool hasPermission(RealName const& realName, Permission permission, bool includeDefault = true) const;
 
+    /**
+     * @brief 获取玩家权限掩码
+     * @param includeDefault 是否包含默认权限
+     */
+    TPSNDAPI int getPermissionMask(RealName const& realName, bool includeDefault = true) const;
+    TPSNDAPI int getPermissionMask(PlayerId id, bool includeDefault = true) const;
+
     /**
      * @brief 授予玩家权限
      */
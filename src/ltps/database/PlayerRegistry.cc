@@ -0,0 +1,173 @@
+#include "ltps/database/PlayerRegistry.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/utils/JsonUtls.h"
+#include "mc/platform/UUID.h"
+#include "mc/world/actor/player/Player.h"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <charconv>
+#include <mutex>
+#include <string_view>
+
+
+namespace ltps {
+
+
+PlayerRegistry::PlayerRegistry() = default;
+
+void PlayerRegistry::load() {
+    auto& db = getDatabase();
+
+    if (!db.has(STORAGE_KEY)) {
+        db.set(STORAGE_KEY, "[]");
+    }
+
+    auto rawJson = db.get(STORAGE_KEY);
+    if (!rawJson.has_value()) {
+        throw std::runtime_error("Could not load player registry");
+    }
+
+    try {
+        auto json = nlohmann::json::parse(rawJson.value());
+        if (!json.is_array()) {
+            throw std::runtime_error("Could not parse player registry");
+        }
+
+        std::vector<Entry> entries;
+        json_utils::json2struct(entries, json);
+
+        std::unique_lock lock{mMutex};
+        mEntries.assign(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+        for (PlayerId id = 0; id < mEntries.size(); ++id) {
+            _index(id);
+        }
+
+        TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} registered players", mEntries.size());
+    } catch (const nlohmann::json::parse_error& e) {
+        throw std::runtime_error("Could not parse player registry");
+    }
+}
+
+void PlayerRegistry::unload() { writeBack(); }
+
+void PlayerRegistry::writeBack() {
+    std::vector<Entry> entries;
+    {
+        std::shared_lock lock{mMutex};
+        entries.assign(mEntries.begin(), mEntries.end());
+    }
+    auto json = json_utils::struct2json(entries);
+    getDatabase().set(STORAGE_KEY, json.dump());
+}
+
+void PlayerRegistry::_index(PlayerId id) {
+    auto& entry = mEntries[id];
+    mByName[entry.name] = id;
+    for (auto const& former : entry.formerNames) {
+        mByName.try_emplace(former, id); // 曾用名被他人占用时以新玩家为准
+    }
+    if (!entry.uuid.empty()) {
+        mByUuid[entry.uuid] = id;
+    }
+    if (!entry.xuid.empty()) {
+        mByXuid[entry.xuid] = id;
+    }
+}
+
+PlayerId PlayerRegistry::_create(RealName const& realName, std::string uuid, std::string xuid) {
+    auto id = static_cast<PlayerId>(mEntries.size());
+    mEntries.push_back(Entry{.name = realName, .uuid = std::move(uuid), .xuid = std::move(xuid), .formerNames = {}});
+    _index(id);
+    return id;
+}
+
+PlayerId PlayerRegistry::find(RealName const& realName) const {
+    std::shared_lock lock{mMutex};
+    auto             iter = mByName.find(realName);
+    return iter == mByName.end() ? InvalidPlayerId : iter->second;
+}
+
+PlayerId PlayerRegistry::getOrCreate(RealName const& realName) {
+    if (auto id = find(realName); id != InvalidPlayerId) {
+        return id;
+    }
+    std::unique_lock lock{mMutex};
+    if (auto iter = mByName.find(realName); iter != mByName.end()) {
+        return iter->second;
+    }
+    return _create(realName, {}, {});
+}
+
+PlayerId PlayerRegistry::registerPlayer(Player& player) {
+    auto realName = player.getRealName();
+    auto uuid     = player.getUuid().asString();
+    auto xuid     = player.getXuid();
+
+    std::unique_lock lock{mMutex};
+
+    auto id = InvalidPlayerId;
+    if (auto iter = mByUuid.find(uuid); iter != mByUuid.end()) {
+        id = iter->second;
+    } else if (auto iter = mByXuid.find(xuid); !xuid.empty() && iter != mByXuid.end()) {
+        id = iter->second;
+    } else if (auto iter = mByName.find(realName); iter != mByName.end() && mEntries[iter->second].uuid.empty()) {
+        id = iter->second; // 旧数据只有玩家名，首次进服时补全 UUID / XUID
+    }
+
+    if (id == InvalidPlayerId) {
+        return _create(realName, std::move(uuid), std::move(xuid));
+    }
+
+    auto& entry = mEntries[id];
+    if (entry.name != realName) {
+        // 改名：保留旧名映射，数据随 Id 迁移到新名下
+        if (std::find(entry.formerNames.begin(), entry.formerNames.end(), entry.name) == entry.formerNames.end()) {
+            entry.formerNames.push_back(entry.name);
+        }
+        entry.name = realName;
+    }
+    entry.uuid = std::move(uuid);
+    if (!xuid.empty()) {
+        entry.xuid = std::move(xuid);
+    }
+    _index(id);
+    return id;
+}
+
+RealName PlayerRegistry::getName(PlayerId id) const {
+    std::shared_lock lock{mMutex};
+    return id < mEntries.size() ? mEntries[id].name : RealName{};
+}
+
+std::string PlayerRegistry::getStorageKey(PlayerId id) const {
+    std::shared_lock lock{mMutex};
+    if (id >= mEntries.size()) {
+        return {};
+    }
+    auto const& name = mEntries[id].name;
+    if (auto iter = mByName.find(name); iter != mByName.end() && iter->second != id) {
+        return IdKeyPrefix + std::to_string(id);
+    }
+    return name;
+}
+
+PlayerId PlayerRegistry::resolveStorageKey(std::string const& key) {
+    if (key.starts_with(IdKeyPrefix)) { // 玩家名不含 '#'
+        PlayerId id{};
+        auto     digits = std::string_view{key}.substr(1);
+        auto     result = std::from_chars(digits.data(), digits.data() + digits.size(), id);
+        if (result.ec != std::errc{} || result.ptr != digits.data() + digits.size() || id >= size()) {
+            return InvalidPlayerId;
+        }
+        return id;
+    }
+    return getOrCreate(key);
+}
+
+std::size_t PlayerRegistry::size() const {
+    std::shared_lock lock{mMutex};
+    return mEntries.size();
+}
+
+
+} // namespace ltps
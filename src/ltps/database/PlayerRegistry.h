@@ -0,0 +1,84 @@
+#pragma once
+#include "ltps/Global.h"
+#include "ltps/database/IStorage.h"
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+class Player;
+
+namespace ltps {
+
+
+using PlayerId = uint32_t;
+
+inline constexpr PlayerId InvalidPlayerId = static_cast<PlayerId>(-1);
+
+
+/**
+ * @brief 玩家注册表
+ * 为每个玩家分配稠密的 32 位 Id（持久化，永不回收），其它 Storage 以 Id 为下标存储玩家数据。
+ * 通过 UUID / XUID 识别改名，改名后旧名仍可解析到同一 Id。
+ * 必须先于其它 Storage 注册（加载）。
+ */
+class PlayerRegistry final : public IStorage {
+public:
+    struct Entry {
+        RealName              name;        // 当前玩家名
+        std::string           uuid;        // UUID (未知时为空)
+        std::string           xuid;        // XUID (未知时为空)
+        std::vector<RealName> formerNames; // 曾用名
+    };
+
+private:
+    std::deque<Entry>                         mEntries; // Id -> Entry
+    std::unordered_map<RealName, PlayerId>    mByName;  // 玩家名 / 曾用名 -> Id
+    std::unordered_map<std::string, PlayerId> mByUuid;
+    std::unordered_map<std::string, PlayerId> mByXuid;
+    mutable std::shared_mutex                 mMutex; // 回写在线程池执行
+
+    PlayerId _create(RealName const& realName, std::string uuid, std::string xuid);
+    void     _index(PlayerId id);
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(PlayerRegistry);
+
+    TPSAPI explicit PlayerRegistry();
+
+    TPSAPI void load() override;
+    TPSAPI void unload() override;
+    TPSAPI void writeBack() override;
+
+    // 查找玩家 Id，不存在返回 InvalidPlayerId
+    TPSNDAPI PlayerId find(RealName const& realName) const;
+
+    // 获取或分配玩家 Id（仅玩家名，用于离线数据 / 管理命令）
+    TPSNDAPI PlayerId getOrCreate(RealName const& realName);
+
+    // 玩家进服时登记，补全 UUID / XUID 并处理改名
+    TPSAPI PlayerId registerPlayer(Player& player);
+
+    // 获取玩家当前名称，Id 无效时返回空字符串
+    TPSNDAPI RealName getName(PlayerId id) const;
+
+    /**
+     * @brief 玩家数据的序列化键
+     * 通常为玩家名；改名后尚未进服的玩家与新玩家同名时，名称归新玩家，旧玩家使用 "#<Id>"，避免互相覆盖。
+     */
+    TPSNDAPI std::string getStorageKey(PlayerId id) const;
+
+    // 解析序列化键，"#<Id>" 超出范围时返回 InvalidPlayerId，玩家名不存在时分配新 Id
+    TPSNDAPI PlayerId resolveStorageKey(std::string const& key);
+
+    TPSNDAPI std::size_t size() const;
+
+    static inline constexpr auto STORAGE_KEY = "player_registry";
+    static inline constexpr char IdKeyPrefix = '#';
+};
+
+
+} // namespace ltps
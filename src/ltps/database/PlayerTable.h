@@ -0,0 +1,95 @@
+#pragma once
+#include "ltps/Global.h"
+#include "ltps/database/PlayerRegistry.h"
+#include "ltps/utils/JsonUtls.h"
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+namespace ltps {
+
+
+/**
+ * @brief 以 PlayerId 为下标的玩家数据表
+ * 查询为数组下标访问；序列化时仍以玩家名为键，保持存储格式不变。
+ */
+template <typename T>
+class PlayerTable {
+    std::vector<std::optional<T>> mSlots;
+    std::size_t                   mSize{0};
+
+public:
+    [[nodiscard]] bool contains(PlayerId id) const { return id < mSlots.size() && mSlots[id].has_value(); }
+
+    [[nodiscard]] T* find(PlayerId id) { return contains(id) ? &*mSlots[id] : nullptr; }
+    [[nodiscard]] T const* find(PlayerId id) const { return contains(id) ? &*mSlots[id] : nullptr; }
+
+    // 获取数据，不存在时默认构造
+    T& operator[](PlayerId id) {
+        if (id >= mSlots.size()) {
+            mSlots.resize(static_cast<std::size_t>(id) + 1);
+        }
+        if (!mSlots[id]) {
+            mSlots[id].emplace();
+            ++mSize;
+        }
+        return *mSlots[id];
+    }
+
+    bool erase(PlayerId id) {
+        if (!contains(id)) {
+            return false;
+        }
+        mSlots[id].reset();
+        --mSize;
+        return true;
+    }
+
+    [[nodiscard]] std::size_t size() const { return mSize; }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (PlayerId id = 0; id < mSlots.size(); ++id) {
+            if (mSlots[id]) {
+                fn(id, *mSlots[id]);
+            }
+        }
+    }
+
+    // 从 begin 开始按 Id 升序遍历，fn 返回 false 时停止
+    template <typename Fn>
+    void forEachFrom(PlayerId begin, Fn&& fn) const {
+        for (PlayerId id = begin; id < mSlots.size(); ++id) {
+            if (mSlots[id] && !fn(id, *mSlots[id])) {
+                return;
+            }
+        }
+    }
+
+    // { realName: T }，玩家名冲突时使用 "#<Id>"（见 PlayerRegistry::getStorageKey）
+    [[nodiscard]] nlohmann::ordered_json toJson(PlayerRegistry const& registry) const {
+        auto json = nlohmann::ordered_json::object();
+        forEach([&](PlayerId id, T const& value) {
+            json[registry.getStorageKey(id)] = json_utils::struct2json(value);
+        });
+        return json;
+    }
+
+    template <class J>
+    void fromJson(PlayerRegistry& registry, J& json) {
+        for (auto& [key, value] : json.items()) {
+            auto id = registry.resolveStorageKey(key);
+            if (id == InvalidPlayerId) {
+                continue;
+            }
+            T data{};
+            json_utils::json2structTryPatch(data, value);
+            (*this)[id] = std::move(data);
+        }
+    }
+};
+
+
+} // namespace ltps
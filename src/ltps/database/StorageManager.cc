@@ -37,7 +37,7 @@ StorageManager::~StorageManager() {
 }
 
 void StorageManager::postLoad() {
-    for (auto& [_, storage] : mStorages) {
+    for (auto& storage : mStorages) {
         try {
             storage->load();
         } catch (const std::exception& e) {
@@ -53,7 +53,7 @@ void StorageManager::postLoad() {
     }
 }
 void StorageManager::postUnload() {
-    for (auto& [_, storage] : mStorages) {
+    for (auto& storage : mStorages) {
         try {
             storage->unload();
         } catch (const std::exception& e) {
@@ -69,7 +69,7 @@ void StorageManager::postUnload() {
     }
 }
 void StorageManager::postWriteBack() {
-    for (auto& [_, storage] : mStorages) {
+    for (auto& storage : mStorages) {
         try {
             storage->writeBack();
         } catch (const std::exception& e) {
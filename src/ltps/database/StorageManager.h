@@ -8,6 +8,7 @@
 #include <string>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 
 namespace ltps {
@@ -15,7 +16,8 @@ namespace ltps {
 class StorageManager final {
 private:
     std::unique_ptr<ll::data::KeyValueDB>                          mDatabase;
-    std::unordered_map<std::type_index, std::unique_ptr<IStorage>> mStorages;
+    std::vector<std::unique_ptr<IStorage>>                         mStorages; // 按注册顺序加载 / 回写
+    std::unordered_map<std::type_index, IStorage*>                 mStorageIndex;
     std::shared_ptr<ll::coro::InterruptableSleep>                  mInterruptableSleep{nullptr};
     std::shared_ptr<std::atomic_bool>                              mWriteBackTaskAbortFlag{nullptr};
 
@@ -34,23 +36,26 @@ class StorageManager final {
     TPSAPI void postUnload();    // 通知所有Storage实例卸载
     TPSAPI void postWriteBack(); // 通知所有Storage实例回写
 
-    // 注册一个Storage实例
+    // 注册一个Storage实例（加载顺序与注册顺序一致）
     template <typename T, typename... Args>
         requires std::derived_from<T, IStorage> && std::is_final_v<T>
     void registerStorage(Args&&... args) {
-        auto storage         = std::make_unique<T>(std::forward<Args>(args)...);
-        mStorages[typeid(T)] = std::move(storage);
+        if (mStorageIndex.contains(typeid(T))) {
+            return;
+        }
+        auto& storage            = mStorages.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
+        mStorageIndex[typeid(T)] = storage.get();
     }
 
     // 获取一个Storage实例
     template <typename T>
         requires std::derived_from<T, IStorage> && std::is_final_v<T>
     [[nodiscard]] T* getStorage() {
-        auto it = mStorages.find(typeid(T));
-        if (it == mStorages.end()) {
+        auto it = mStorageIndex.find(typeid(T));
+        if (it == mStorageIndex.end()) {
             return nullptr;
         }
-        return static_cast<T*>(it->second.get());
+        return static_cast<T*>(it->second);
     }
 };
 
@@ -28,6 +28,8 @@ class IModule {
 
     [[nodiscard]] virtual bool disable() = 0;
 
+    virtual void onConfigReload() {} // 配置重载后，保持启用的模块重新读取配置
+
     TPSNDAPI bool isEnabled() const;
 
 protected:
@@ -171,6 +171,19 @@ void ModuleManager::reconfigureModules() {
             }
         }
     }
+
+    // 通知保持启用的模块配置已重载
+    for (auto module : sortedModules) {
+        auto const name = module->getModuleName();
+
+        if (module->isEnabled() && enabledModules.find(name) == enabledModules.end()) {
+            try {
+                module->onConfigReload();
+            } catch (std::exception const& e) {
+                logger.error("Failed to reload config for module {}: {}", name, e.what());
+            }
+        }
+    }
 }
 
 std::vector<IModule*> ModuleManager::sortModulesByDependency() {
@@ -6,15 +6,16 @@
 #include "ltps/TeleportSystem.h"
 #include "ltps/base/Config.h"
 #include "ltps/common/PriceCalculate.h"
+#include "ltps/common/RateLimiter.h"
 #include "ltps/database/StorageManager.h"
 #include "ltps/utils/McUtils.h"
 
-#include "../setting/SettingStorage.h"
 #include "ll/api/event/player/PlayerDieEvent.h"
 #include "ll/api/event/player/PlayerRespawnEvent.h"
 
 #include <ll/api/event/EventBus.h>
 #include <mc/world/actor/player/Player.h>
+#include <utility>
 
 namespace ltps ::death {
 
@@ -37,6 +38,12 @@ bool DeathModule::enable() {
             auto       realName   = player.getRealName();
             auto       localeCode = player.getLocaleCode();
 
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(realName)) {
+                limiter.sendRateLimitedMessage(player, localeCode);
+                ev.cancel();
+                return;
+            }
+
             auto info = getStorage()->getSpecificDeathInfo(realName, index);
             if (!info.has_value()) {
                 mc_utils::sendText<mc_utils::Error>(player, "没有找到对应的死亡信息"_trl(localeCode));
@@ -53,11 +60,18 @@ bool DeathModule::enable() {
                 return;
             }
 
-            info->teleport(player);
-            mc_utils::sendText(player, "传送成功"_trl(localeCode));
-
-            auto backed = BackedDeathPointEvent{player, *info, index};
-            bus.publish(backed);
+            TeleportSystem::getInstance().getTeleportDispatcher().dispatch(
+                player,
+                info->dimid,
+                [info = *info, index, localeCode](Player& self) {
+                    info.teleport(self);
+                    mc_utils::sendText(self, "传送成功"_trl(localeCode));
+
+                    auto backed = BackedDeathPointEvent{self, info, index};
+                    ll::event::EventBus::getInstance().publish(backed);
+                },
+                TeleportDispatcher::makeRefund(player, backing.getCharged())
+            );
         },
         ll::event::EventPriority::High
     ));
@@ -93,6 +107,7 @@ bool DeathModule::enable() {
                 ev.cancel();
                 return;
             }
+            ev.setCharged(static_cast<llong>(price.value()));
         },
         ll::event::EventPriority::High
     ));
@@ -124,8 +139,7 @@ bool DeathModule::enable() {
             return;
         }
 
-        if (auto ps = getStorageManager().getStorage<setting::SettingStorage>();
-            ps && ps->getSettingData(player.getRealName())->deathPopup) {
+        if (TeleportSystem::getInstance().getSessionManager().getSession(player).getSettings().deathPopup) {
             DeathGUI::sendBackGUI(player);
         }
     }));
@@ -32,7 +32,7 @@ void DeathStorage::load() {
             throw std::runtime_error("Could not parse death data");
         }
 
-        json_utils::json2structTryPatch(mDeathInfoMap, json);
+        mDeathInfoMap.fromJson(getPlayerRegistry(), json);
         TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} death infos", mDeathInfoMap.size());
     } catch (const nlohmann::json::parse_error& e) {
         throw std::runtime_error("Could not parse death data");
@@ -43,62 +43,58 @@ void DeathStorage::unload() { writeBack(); }
 
 void DeathStorage::writeBack() {
     auto& db   = getDatabase();
-    auto  json = json_utils::struct2json(mDeathInfoMap);
+    auto  json = mDeathInfoMap.toJson(getPlayerRegistry());
     db.set(STORAGE_KEY, json.dump());
 }
 
-bool DeathStorage::hasDeathInfo(RealName const& realName) const {
-    return mDeathInfoMap.contains(realName) && !mDeathInfoMap.at(realName).empty();
-}
+bool DeathStorage::hasDeathInfo(RealName const& realName) const { return getDeathInfos(realName) != nullptr; }
 
 void DeathStorage::addDeathInfo(RealName const& realName, DeathInfo deathInfo) {
-    if (!hasDeathInfo(realName)) {
-        mDeathInfoMap[realName] = {};
-    }
-    auto& deathInfos = mDeathInfoMap[realName];
+    auto& deathInfos = mDeathInfoMap[getPlayerRegistry().getOrCreate(realName)];
     deathInfos.insert(deathInfos.begin(), std::move(deathInfo)); // 插入到最前面
-
     if (deathInfos.size() > getConfig().modules.death.maxDeathInfos) {
         deathInfos.pop_back(); // 删除最后一个
     }
 }
 
 DeathStorage::DeathInfos const* DeathStorage::getDeathInfos(RealName const& realName) const {
-    if (!hasDeathInfo(realName)) {
+    return getDeathInfos(getPlayerRegistry().find(realName));
+}
+
+DeathStorage::DeathInfos const* DeathStorage::getDeathInfos(PlayerId id) const {
+    auto deathInfos = mDeathInfoMap.find(id);
+    if (!deathInfos || deathInfos->empty()) {
         return nullptr;
     }
-    return &mDeathInfoMap.at(realName);
+    return deathInfos;
 }
 
 std::optional<DeathStorage::DeathInfo> DeathStorage::getLatestDeathInfo(RealName const& realName) const {
-    if (!hasDeathInfo(realName)) {
+    auto deathInfos = getDeathInfos(realName);
+    if (!deathInfos) {
         return std::nullopt;
     }
-    return mDeathInfoMap.at(realName).front();
+    return deathInfos->front();
 }
 
 std::optional<DeathStorage::DeathInfo> DeathStorage::getSpecificDeathInfo(RealName const& realName, int index) const {
-    if (!hasDeathInfo(realName)) {
+    auto deathInfos = getDeathInfos(realName);
+    if (!deathInfos) {
         return std::nullopt;
     }
-
-    auto& deathInfos = mDeathInfoMap.at(realName);
-    if (index < 0 || index >= deathInfos.size()) {
+    if (index < 0 || index >= deathInfos->size()) {
         return std::nullopt; // 索引超出范围
     }
-    return deathInfos[index];
+    return (*deathInfos)[index];
 }
 
-
 bool DeathStorage::clearDeathInfo(RealName const& realName) {
     if (!hasDeathInfo(realName)) {
         return false;
     }
-    mDeathInfoMap.erase(realName);
-    return true;
+    return mDeathInfoMap.erase(getPlayerRegistry().find(realName));
 }
 
-
 DeathStorage::DeathInfo DeathStorage::DeathInfo::make(Vec3 const& pos, int dimid) {
     return {.time = time_utils::getCurrentTimeString(), .x = pos.x, .y = pos.y, .z = pos.z, .dimid = dimid};
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "ltps/database/IStorage.h"
+#include "ltps/database/PlayerTable.h"
 
 
 class Vec3;
@@ -22,7 +23,7 @@ class DeathStorage final : public IStorage {
         TPSNDAPI std::string toPosString() const;
     };
     using DeathInfos   = std::vector<DeathInfo>;
-    using DeathInfoMap = std::unordered_map<RealName, DeathInfos>;
+    using DeathInfoMap = PlayerTable<DeathInfos>;
 
 private:
     DeathInfoMap mDeathInfoMap;
@@ -41,6 +42,7 @@ class DeathStorage final : public IStorage {
     TPSAPI void addDeathInfo(RealName const& realName, DeathInfo deathInfo);
 
     TPSNDAPI DeathInfos const* getDeathInfos(RealName const& realName) const;
+    TPSNDAPI DeathInfos const* getDeathInfos(PlayerId id) const;
 
     TPSNDAPI std::optional<DeathInfo> getLatestDeathInfo(RealName const& realName) const;
     TPSNDAPI std::optional<DeathInfo> getSpecificDeathInfo(RealName const& realName, int index) const;
@@ -30,6 +30,9 @@ int IBackDeathPointEvent::getIndex() const { return mIndex; }
 BackingDeathPointEvent::BackingDeathPointEvent(Player& player, DeathStorage::DeathInfo const& deathInfo, int index)
 : IBackDeathPointEvent(player, deathInfo, index) {}
 
+void      BackingDeathPointEvent::setCharged(long long charged) { mCharged = charged; }
+long long BackingDeathPointEvent::getCharged() const { return mCharged; }
+
 BackedDeathPointEvent::BackedDeathPointEvent(Player& player, DeathStorage::DeathInfo const& deathInfo, int index)
 : IBackDeathPointEvent(player, deathInfo, index) {}
 
@@ -45,8 +45,13 @@ class IBackDeathPointEvent {
  * @brief 玩家传送回死亡点事件
  */
 class BackingDeathPointEvent final : public Cancellable<Event>, public IBackDeathPointEvent {
+    long long mCharged{0}; // 监听者扣除的费用，传送被分发队列丢弃时退还
+
 public:
     TPSAPI explicit BackingDeathPointEvent(Player& player, DeathStorage::DeathInfo const& deathInfo, int index);
+
+    TPSAPI void        setCharged(long long charged);
+    TPSNDAPI long long getCharged() const;
 };
 
 /**
@@ -15,7 +15,7 @@ void DeathGUI::sendMainMenu(Player& player, BackCB backCb) {
     auto localeCode = player.getLocaleCode();
 
     auto infos = TeleportSystem::getInstance().getStorageManager().getStorage<DeathStorage>()->getDeathInfos(
-        player.getRealName()
+        TeleportSystem::getInstance().getSessionManager().getSession(player).getPlayerId()
     );
 
     if (!infos || infos->empty()) {
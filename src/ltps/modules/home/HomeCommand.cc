@@ -76,7 +76,17 @@ void HomeCommand::setup() {
 
             auto home = storage->getHome(player.getRealName(), param.name);
             if (!home) {
-                mc_utils::sendText<mc_utils::Error>(output, "未找到该家园"_trl(localeCode));
+                auto& session = TeleportSystem::getInstance().getSessionManager().getSession(player);
+                auto  matches = storage->queryHomes(session.getRealName(), param.name);
+                if (matches.empty()) {
+                    mc_utils::sendText<mc_utils::Error>(output, "未找到该家园"_trl(localeCode));
+                    return;
+                }
+                std::string text = "找到 {} 个相似的家园:"_trl(localeCode, matches.size());
+                for (const auto& match : matches) {
+                    text += fmt::format(" ,{}", match.name);
+                }
+                mc_utils::sendText<mc_utils::Info>(output, text);
                 return;
             }
 
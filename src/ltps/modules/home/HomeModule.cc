@@ -7,6 +7,7 @@
 #include "ltps/base/Config.h"
 #include "ltps/common/EconomySystem.h"
 #include "ltps/common/PriceCalculate.h"
+#include "ltps/common/RateLimiter.h"
 #include "ltps/database/PermissionStorage.h"
 #include "ltps/database/StorageManager.h"
 #include "ltps/modules/home/HomeCommand.h"
@@ -34,6 +35,12 @@ bool HomeModule::enable() {
             auto            localeCode = player.getLocaleCode();
             RealName const& realName   = player.getRealName();
 
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(realName)) {
+                limiter.sendRateLimitedMessage(player, localeCode);
+                ev.cancel();
+                return;
+            }
+
             auto home = HomeStorage::Home::make(player.getPosition(), player.getDimensionId(), ev.getName());
 
             auto& bus = ll::event::EventBus::getInstance();
@@ -117,10 +124,9 @@ bool HomeModule::enable() {
                 }
             }
 
-            bool unLimited = false;
-            if (auto pe = getStorageManager().getStorage<PermissionStorage>()) {
-                unLimited = pe->hasPermission(realName, PermissionStorage::Permission::UnlimitedHome);
-            }
+            bool unLimited = TeleportSystem::getInstance().getSessionManager().getSession(player).hasPermission(
+                PermissionStorage::Permission::UnlimitedHome
+            );
 
             if (count > getConfig().modules.home.maxHome && !unLimited) {
                 mc_utils::sendText<mc_utils::Error>(player, "家园数量超过上限，无法创建"_trl(localeCode));
@@ -209,6 +215,12 @@ bool HomeModule::enable() {
             auto  localeCode = player.getLocaleCode();
             auto& name       = ev.getName();
 
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(realName)) {
+                limiter.sendRateLimitedMessage(player, localeCode);
+                ev.cancel();
+                return;
+            }
+
             auto storage = getStorage();
             if (!storage) {
                 throw std::runtime_error("HomeStorage not found");
@@ -229,11 +241,18 @@ bool HomeModule::enable() {
                 return;
             }
 
-            home->teleport(player);
+            TeleportSystem::getInstance().getTeleportDispatcher().dispatch(
+                player,
+                home->dimid,
+                [home = *home](Player& self) {
+                    home.teleport(self);
 
-            auto teleported = HomeTeleportedEvent(player, home.value());
+                    auto teleported = HomeTeleportedEvent(self, home);
 
-            bus.publish(teleported);
+                    ll::event::EventBus::getInstance().publish(teleported);
+                },
+                TeleportDispatcher::makeRefund(player, teleporting.getCharged(), mCooldown.getColumn())
+            );
             ev.invokeCallback(home.value());
         },
         ll::event::EventPriority::High
@@ -242,15 +261,17 @@ bool HomeModule::enable() {
     mListeners.emplace_back(bus.emplaceListener<HomeTeleportingEvent>(
         [this](HomeTeleportingEvent& ev) {
             auto& player     = ev.getPlayer();
-            auto  realName   = player.getRealName();
-            auto  localeCode = player.getLocaleCode();
+            auto& session    = TeleportSystem::getInstance().getSessionManager().getSession(player);
+            auto& realName   = session.getRealName();
+            auto& localeCode = session.getLocaleCode();
 
-            auto& cooldown = getCooldown();
+            auto& cooldown   = getCooldown();
+            auto  cooldownId = session.getCooldownId();
 
-            if (cooldown.isCooldown(realName)) {
+            if (cooldown.isCooldown(cooldownId)) {
                 mc_utils::sendText(
                     player,
-                    "传送冷却中, 请稍后重试，冷却时间: {}"_trl(localeCode, cooldown.getCooldownString(realName))
+                    "传送冷却中, 请稍后重试，冷却时间: {}"_trl(localeCode, cooldown.getCooldownString(cooldownId))
                 );
                 ev.cancel();
                 return;
@@ -278,8 +299,9 @@ bool HomeModule::enable() {
                 ev.cancel();
                 return;
             }
+            ev.setCharged(static_cast<llong>(price.value()));
 
-            cooldown.setCooldown(realName, getConfig().modules.home.cooldownTime);
+            cooldown.setCooldown(cooldownId, getConfig().modules.home.cooldownTime);
         },
         ll::event::EventPriority::High
     ));
@@ -372,10 +394,16 @@ bool HomeModule::enable() {
                 return;
             }
 
-            home.teleport(player);
+            TeleportSystem::getInstance().getTeleportDispatcher().dispatch(
+                player,
+                home.dimid,
+                [target, home](Player& self) {
+                    home.teleport(self);
 
-            auto ed = AdminTeleportedPlayerHomeEvent{player, target, home};
-            bus.publish(ed);
+                    auto ed = AdminTeleportedPlayerHomeEvent{self, target, home};
+                    ll::event::EventBus::getInstance().publish(ed);
+                }
+            );
         },
         ll::event::EventPriority::High
     ));
@@ -9,7 +9,7 @@
 namespace ltps::home {
 
 class HomeModule final : public IModule {
-    Cooldown                            mCooldown;
+    Cooldown                            mCooldown{CooldownTable::Column::Home};
     std::vector<ll::event::ListenerPtr> mListeners;
 
 public:
@@ -33,12 +33,17 @@ void HomeStorage::load() {
             throw std::runtime_error("Could not parse home data");
         }
 
-        // for (auto& [key, value] : json.items()) {
-        //     Home home;
-        //     json_utils::json2structTryPatch(home, value);
-        //     mHomes[key].push_back(std::move(home));
-        // }
-        json_utils::json2struct(mHomes, json);
+        mHomes.fromJson(getPlayerRegistry(), json);
+
+        mSpatialIndex.clear();
+        mRecent.clear();
+        mLastModified = {};
+        mHomes.forEach([this](PlayerId id, Homes const& homes) {
+            for (auto const& home : homes) {
+                _indexPosition(id, home);
+            }
+            _refreshRecent(id);
+        });
 
         TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} homes", mHomes.size());
     } catch (const nlohmann::json::parse_error& e) {
@@ -51,91 +56,221 @@ void HomeStorage::unload() { writeBack(); }
 void HomeStorage::writeBack() {
     auto& db = getDatabase();
 
-    auto json = json_utils::struct2json(mHomes);
+    auto json = mHomes.toJson(getPlayerRegistry());
     db.set(STORAGE_KEY, json.dump());
 }
 
-bool HomeStorage::hasPlayer(RealName const& realName) const { return mHomes.contains(realName); }
+void HomeStorage::_indexPosition(PlayerId id, Home const& home) {
+    mSpatialIndex.insert({id, home.name}, {home.dimid, home.x, home.y, home.z});
+}
+
+void HomeStorage::_refreshRecent(PlayerId id) {
+    if (auto last = mLastModified.find(id)) {
+        mRecent.erase({*last, id});
+        mLastModified.erase(id);
+    }
+    auto homes = mHomes.find(id);
+    if (!homes || homes->empty()) {
+        return;
+    }
+    auto latest = std::max_element(homes->begin(), homes->end(), [](Home const& a, Home const& b) {
+        return a.modifiedTime < b.modifiedTime; // yyyy-MM-dd HH:mm:ss 可直接按字典序比较
+    });
+    mLastModified[id] = latest->modifiedTime;
+    mRecent.emplace(latest->modifiedTime, id);
+}
+
+HomeStorage::Homes* HomeStorage::_find(RealName const& realName) {
+    return mHomes.find(getPlayerRegistry().find(realName));
+}
+
+HomeStorage::Homes const* HomeStorage::_find(RealName const& realName) const {
+    return mHomes.find(getPlayerRegistry().find(realName));
+}
+
+bool HomeStorage::hasPlayer(RealName const& realName) const { return _find(realName) != nullptr; }
 
 bool HomeStorage::hasHome(RealName const& realName, std::string const& name) {
-    if (!mHomes.contains(realName)) {
+    auto homes = _find(realName);
+    if (!homes) {
         return false;
     }
-    return std::any_of(mHomes[realName].begin(), mHomes[realName].end(), [&](Home const& home) {
-        return home.name == name;
-    });
+    return std::any_of(homes->begin(), homes->end(), [&](Home const& home) { return home.name == name; });
 }
 
 std::optional<HomeStorage::Home> HomeStorage::getHome(RealName const& realName, std::string const& name) {
-    if (!mHomes.contains(realName)) {
+    auto homes = _find(realName);
+    if (!homes) {
         return std::nullopt;
     }
-    auto it = std::find_if(mHomes[realName].begin(), mHomes[realName].end(), [&](Home const& home) {
-        return home.name == name;
-    });
-    if (it == mHomes[realName].end()) {
+    auto it = std::find_if(homes->begin(), homes->end(), [&](Home const& home) { return home.name == name; });
+    if (it == homes->end()) {
         return std::nullopt;
     }
     return *it;
 }
 
 Result<void> HomeStorage::updateHome(RealName const& realName, std::string const& name, Home home) {
-    if (!mHomes.contains(realName)) {
+    auto homes = _find(realName);
+    if (!homes) {
         return std::unexpected{"Home not found"};
     };
 
-    auto& homes = mHomes[realName];
-
-    auto it = std::find_if(homes.begin(), homes.end(), [&](Home const& h) { return h.name == name; });
-    if (it == homes.end()) {
+    auto it = std::find_if(homes->begin(), homes->end(), [&](Home const& h) { return h.name == name; });
+    if (it == homes->end()) {
         return std::unexpected{"Home not found"};
     }
+    if (home.name != name
+        && std::any_of(homes->begin(), homes->end(), [&](Home const& h) { return h.name == home.name; })) {
+        return std::unexpected{"Home name repeated"};
+    }
+
+    auto id = getPlayerRegistry().find(realName);
+    if (home.name != name) {
+        mSpatialIndex.erase({id, name});
+    }
+    _indexPosition(id, home);
 
     home.updateModifiedTime();
     *it = std::move(home);
+    _refreshRecent(id);
     return {};
 }
 
 Result<void> HomeStorage::addHome(RealName const& realName, Home home) {
-    if (!mHomes.contains(realName)) {
-        mHomes[realName] = {};
-    }
     if (hasHome(realName, home.name)) {
         return std::unexpected("Home name repeated");
     }
-    mHomes[realName].push_back(std::move(home));
+    auto id = getPlayerRegistry().getOrCreate(realName);
+    _indexPosition(id, home);
+    mHomes[id].push_back(std::move(home));
+    _refreshRecent(id);
     return {};
 }
 
 Result<void> HomeStorage::removeHome(RealName const& realName, std::string const& name) {
-    if (!mHomes.contains(realName)) {
+    auto homes = _find(realName);
+    if (!homes) {
         return std::unexpected{"Home not found"};
     }
-    auto it =
-        std::remove_if(mHomes[realName].begin(), mHomes[realName].end(), [&](Home const& h) { return h.name == name; });
-    if (it == mHomes[realName].end()) {
+    auto it = std::remove_if(homes->begin(), homes->end(), [&](Home const& h) { return h.name == name; });
+    if (it == homes->end()) {
         return std::unexpected{"Home not found"};
     }
-    mHomes[realName].erase(it, mHomes[realName].end());
+    homes->erase(it, homes->end());
+    auto id = getPlayerRegistry().find(realName);
+    mSpatialIndex.erase({id, name});
+    _refreshRecent(id);
     return {};
 }
 
 Result<int> HomeStorage::getHomeCount(RealName const& realName) const {
-    if (!mHomes.contains(realName)) {
+    auto homes = _find(realName);
+    if (!homes) {
         return std::unexpected("Player not found");
     }
-    return mHomes.at(realName).size();
+    return static_cast<int>(homes->size());
 }
 
 HomeStorage::Homes const& HomeStorage::getHomes(RealName const& realName) {
-    if (!mHomes.contains(realName)) {
-        mHomes[realName] = {};
-    }
-    return mHomes[realName];
+    return getHomes(getPlayerRegistry().find(realName));
+}
+
+HomeStorage::Homes const& HomeStorage::getHomes(PlayerId id) {
+    static Homes const empty{};
+    auto               homes = mHomes.find(id);
+    return homes ? *homes : empty;
 }
 
 HomeStorage::HomeMap const& HomeStorage::getAllHomes() const { return mHomes; }
 
+HomeStorage::Homes
+HomeStorage::queryHomes(RealName const& realName, std::string const& keyword, std::size_t limit) const {
+    auto homes = _find(realName);
+    auto query = NameIndex::normalize(keyword);
+    if (!homes || query.empty()) {
+        return {};
+    }
+
+    std::vector<std::pair<NameIndex::MatchKind, Home const*>> ranked;
+    for (auto const& home : *homes) {
+        if (auto kind = NameIndex::match(query, home.name)) {
+            ranked.emplace_back(*kind, &home);
+        }
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+
+    Homes result;
+    for (std::size_t i = 0; i < ranked.size() && i < limit; ++i) {
+        result.push_back(*ranked[i].second);
+    }
+    return result;
+}
+
+std::vector<std::pair<HomeStorage::HomeKey, float>>
+HomeStorage::getNearestHomes(int dimId, Vec3 const& pos, std::size_t count, float maxDistance) const {
+    std::vector<std::pair<HomeKey, float>> result;
+    for (auto& [key, distance] : mSpatialIndex.nearest(dimId, pos.x, pos.y, pos.z, count, maxDistance)) {
+        result.emplace_back(std::move(key), distance);
+    }
+    return result;
+}
+
+std::vector<HomeStorage::HomeKey>
+HomeStorage::getHomesWithin(int dimId, Vec3 const& corner1, Vec3 const& corner2) const {
+    return mSpatialIndex.within(dimId, corner1.x, corner1.z, corner2.x, corner2.z);
+}
+
+HomeStorage::PlayerPage HomeStorage::listPlayers(
+    PlayerCursor const& cursor,
+    std::size_t         pageSize,
+    PlayerOrder         order,
+    std::string const&  keyword
+) const {
+    auto const& registry = getPlayerRegistry();
+    auto        query    = NameIndex::normalize(keyword);
+
+    PlayerPage   page;
+    PlayerCursor last    = cursor;
+    std::size_t  scanned = 0;
+
+    // 返回 false 时停止遍历；页满或检查数达到上限时以最后检查的玩家作为下一页游标
+    auto visit = [&](PlayerId id, std::string const& modifiedTime, Homes const& homes) {
+        if (page.players.size() >= pageSize || scanned >= PageScanLimit) {
+            page.next = last;
+            return false;
+        }
+        ++scanned;
+        last = PlayerCursor{modifiedTime, id};
+        if (homes.empty()) {
+            return true;
+        }
+        auto realName = registry.getName(id);
+        if (!query.empty() && !NameIndex::match(query, realName)) {
+            return true;
+        }
+        page.players.push_back({id, std::move(realName), homes.size(), modifiedTime});
+        return true;
+    };
+
+    if (order == PlayerOrder::ById) {
+        auto begin = cursor.id == InvalidPlayerId ? PlayerId{0} : cursor.id + 1;
+        mHomes.forEachFrom(begin, [&](PlayerId id, Homes const& homes) {
+            auto modified = mLastModified.find(id);
+            return visit(id, modified ? *modified : std::string{}, homes);
+        });
+        return page;
+    }
+
+    auto iter = cursor.id == InvalidPlayerId ? mRecent.begin() : mRecent.upper_bound({cursor.modifiedTime, cursor.id});
+    for (; iter != mRecent.end(); ++iter) {
+        if (!visit(iter->second, iter->first, *mHomes.find(iter->second))) {
+            break;
+        }
+    }
+    return page;
+}
+
 
 HomeStorage::Home HomeStorage::Home::make(Vec3 const& vec3, int dimid, std::string const& name) {
     auto time = time_utils::getCurrentTimeString();
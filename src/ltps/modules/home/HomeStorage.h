@@ -1,8 +1,15 @@
 #pragma once
 #include "ltps/Global.h"
+#include "ltps/common/NameIndex.h"
+#include "ltps/common/SpatialIndex.h"
 #include "ltps/database/IStorage.h"
+#include "ltps/database/PlayerTable.h"
+#include <cstddef>
+#include <functional>
 #include <optional>
-#include <unordered_map>
+#include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 class Vec3;
@@ -32,10 +39,53 @@ class HomeStorage final : public IStorage {
         TPSNDAPI std::string toPosString() const;
     };
     using Homes   = std::vector<Home>;
-    using HomeMap = std::unordered_map<RealName, Homes>;
+    using HomeMap = PlayerTable<Homes>;
+    using HomeKey = std::pair<PlayerId, std::string>; // 玩家 Id + 家园名称
+
+    struct HomeKeyHash {
+        std::size_t operator()(HomeKey const& key) const {
+            return std::hash<std::string>{}(key.second) ^ (static_cast<std::size_t>(key.first) * 0x9e3779b97f4a7c15ull);
+        }
+    };
+
+    enum class PlayerOrder {
+        ById,        // 玩家 Id 升序（注册先后）
+        LastModified // 家园最近修改时间降序
+    };
+
+    // 玩家列表分页游标，默认构造为第一页
+    struct PlayerCursor {
+        std::string modifiedTime; // 仅 LastModified 使用
+        PlayerId    id{InvalidPlayerId};
+    };
+
+    struct PlayerEntry {
+        PlayerId    id;
+        RealName    realName;
+        std::size_t homeCount;
+        std::string modifiedTime; // 该玩家家园中最近的修改时间
+    };
+
+    struct PlayerPage {
+        std::vector<PlayerEntry>    players;
+        std::optional<PlayerCursor> next; // 没有后续页时为空
+    };
+
+    static inline constexpr std::size_t PageScanLimit = 2048; // 每页最多检查的玩家数（搜索时限制单页开销）
 
 private:
-    HomeMap mHomes; // 玩家名 -> 家
+    using RecentKey = std::pair<std::string, PlayerId>; // 最近修改时间, 玩家 Id
+
+    HomeMap                             mHomes;        // 玩家 Id -> 家
+    SpatialIndex<HomeKey, HomeKeyHash>  mSpatialIndex; // 所有玩家的家园坐标
+    std::set<RecentKey, std::greater<>> mRecent;       // 按最近修改时间排序的玩家（不含无家园的玩家）
+    PlayerTable<std::string>            mLastModified; // 玩家 Id -> mRecent 中的修改时间
+
+    void _indexPosition(PlayerId id, Home const& home);
+    void _refreshRecent(PlayerId id);
+
+    Homes*       _find(RealName const& realName);
+    Homes const* _find(RealName const& realName) const;
 
 public:
     TPSAPI explicit HomeStorage();
@@ -59,9 +109,36 @@ class HomeStorage final : public IStorage {
     TPSNDAPI Result<int> getHomeCount(RealName const& realName) const;
 
     TPSNDAPI Homes const& getHomes(RealName const& realName);
+    TPSNDAPI Homes const& getHomes(PlayerId id);
 
     TPSNDAPI HomeMap const& getAllHomes() const;
 
+    /**
+     * @brief 模糊查询玩家的家园，排序与传送点搜索一致
+     * 单个玩家的家园数受 maxHome 限制，直接逐个匹配，不维护索引。
+     */
+    TPSNDAPI Homes
+    queryHomes(RealName const& realName, std::string const& keyword, std::size_t limit = NameIndex::DefaultLimit) const;
+
+    // 所有玩家中最近的 count 个家园及距离，按距离升序
+    TPSNDAPI std::vector<std::pair<HomeKey, float>>
+             getNearestHomes(int dimId, Vec3 const& pos, std::size_t count, float maxDistance = 1e9f) const;
+
+    // 水平范围内的家园（所有玩家）
+    TPSNDAPI std::vector<HomeKey> getHomesWithin(int dimId, Vec3 const& corner1, Vec3 const& corner2) const;
+
+    /**
+     * @brief 按游标分页列出拥有家园的玩家
+     * 每页最多检查 PageScanLimit 个玩家，搜索无结果时也会返回下一页游标，单页开销与总玩家数无关。
+     * @param keyword 玩家名搜索（同名称搜索规则），为空时不过滤
+     */
+    TPSNDAPI PlayerPage listPlayers(
+        PlayerCursor const& cursor,
+        std::size_t         pageSize,
+        PlayerOrder         order   = PlayerOrder::ById,
+        std::string const&  keyword = {}
+    ) const;
+
     static inline constexpr auto STORAGE_KEY = "home";
 };
 
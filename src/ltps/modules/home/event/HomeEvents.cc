@@ -98,6 +98,9 @@ home::HomeStorage::Home const& ITeleportHomeEvent::getHome() const { return mHom
 HomeTeleportingEvent::HomeTeleportingEvent(Player& player, home::HomeStorage::Home const& home)
 : ITeleportHomeEvent(player, home) {}
 
+void      HomeTeleportingEvent::setCharged(long long charged) { mCharged = charged; }
+long long HomeTeleportingEvent::getCharged() const { return mCharged; }
+
 HomeTeleportedEvent::HomeTeleportedEvent(Player& player, home::HomeStorage::Home const& home)
 : ITeleportHomeEvent(player, home) {}
 
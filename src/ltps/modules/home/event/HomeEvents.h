@@ -129,8 +129,13 @@ class ITeleportHomeEvent {
 };
 
 class HomeTeleportingEvent final : public Cancellable<Event>, public ITeleportHomeEvent {
+    long long mCharged{0}; // 监听者扣除的费用，传送被分发队列丢弃时退还
+
 public:
     TPSAPI explicit HomeTeleportingEvent(Player& player, home::HomeStorage::Home const& home);
+
+    TPSAPI void        setCharged(long long charged);
+    TPSNDAPI long long getCharged() const;
 };
 
 class HomeTeleportedEvent final : public Event, public ITeleportHomeEvent {
@@ -6,6 +6,7 @@
 #include "ltps/TeleportSystem.h"
 #include "ltps/base/Config.h"
 #include "ltps/common/BackSimpleForm.h"
+#include "ltps/common/RateLimiter.h"
 #include "ltps/modules/home/HomeStorage.h"
 #include "ltps/modules/home/event/HomeEvents.h"
 #include "ltps/utils/McUtils.h"
@@ -90,7 +91,7 @@ void HomeGUI::sendChooseHomeGUI(Player& player, ChooseHomeCallback chooseCB) {
 
     auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<HomeStorage>();
 
-    auto homes = storage->getHomes(player.getRealName());
+    auto homes = storage->getHomes(TeleportSystem::getInstance().getSessionManager().getSession(player).getPlayerId());
     for (auto& home : homes) {
         auto _name = home.name; // 拷贝名称，避免 move 后显示空字符串
         fm.appendButton(_name, [chooseCB, home = std::move(home)](Player& self) { chooseCB(self, home); });
@@ -171,6 +172,10 @@ void HomeGUI::_sendEditHomeNameGUI(Player& player, std::string const& name) {
                 mc_utils::sendText<mc_utils::Error>(self, "名称不能为空哦!"_trl(self.getLocaleCode()));
                 return;
             }
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(self)) {
+                limiter.sendRateLimitedMessage(self);
+                return;
+            }
 
             ll::event::EventBus::getInstance().publish(PlayerRequestEditHomeEvent{
                 self,
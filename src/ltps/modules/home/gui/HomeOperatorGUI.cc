@@ -6,6 +6,7 @@
 #include "ltps/Global.h"
 #include "ltps/TeleportSystem.h"
 #include "ltps/common/BackSimpleForm.h"
+#include "ltps/common/RateLimiter.h"
 #include "ltps/modules/home/HomeStorage.h"
 #include "ltps/modules/home/event/HomeEvents.h"
 #include "ltps/modules/home/gui/HomeOperatorGUI.h"
@@ -26,24 +27,92 @@ void HomeOperatorGUI::sendMainGUI(Player& player) {
 }
 
 void HomeOperatorGUI::sendChoosePlayerGUI(Player& player, ChoosePlayerCallback callback) {
+    sendChoosePlayerPage(player, std::move(callback), {});
+}
+
+void HomeOperatorGUI::sendChoosePlayerPage(Player& player, ChoosePlayerCallback callback, PlayerPageState state) {
     auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<HomeStorage>();
     if (!storage) {
         return;
     }
 
     auto localeCode = player.getLocaleCode();
+    auto page       = storage->listPlayers(state.cursors.back(), PlayerPageSize, state.order, state.keyword);
 
     SimpleForm fm{"Teleport System - Home Manager"_trl(localeCode)};
-    fm.setContent("请选择一个玩家: "_trl(localeCode));
+    fm.setContent("第 {} 页 | 排序: {} | 搜索: {}\n请选择一个玩家: "_trl(
+        localeCode,
+        state.cursors.size(),
+        state.order == HomeStorage::PlayerOrder::ById ? "注册顺序"_trl(localeCode) : "最近修改"_trl(localeCode),
+        state.keyword.empty() ? "无"_trl(localeCode) : state.keyword
+    ));
+
+    fm.appendButton(
+        "搜索 / 排序"_trl(localeCode),
+        "textures/ui/magnifyingGlass",
+        "path",
+        [callback, state](Player& self) { sendSearchPlayerGUI(self, callback, state); }
+    );
 
-    auto const& map = storage->getAllHomes();
-    for (auto const& pair : map) {
-        fm.appendButton(pair.first, [callback, target = pair.first](Player& self) { callback(self, target); });
+    if (state.cursors.size() > 1) {
+        auto prev = state;
+        prev.cursors.pop_back();
+        fm.appendButton("上一页"_trl(localeCode), [callback, prev = std::move(prev)](Player& self) {
+            sendChoosePlayerPage(self, callback, prev);
+        });
+    }
+
+    for (auto& entry : page.players) {
+        fm.appendButton(
+            "{}\n{} 个家园 | {}"_trl(localeCode, entry.realName, entry.homeCount, entry.modifiedTime),
+            [callback, target = entry.realName](Player& self) { callback(self, target); }
+        );
+    }
+
+    if (page.next) {
+        auto next = state;
+        next.cursors.push_back(*page.next);
+        fm.appendButton("下一页"_trl(localeCode), [callback, next = std::move(next)](Player& self) {
+            sendChoosePlayerPage(self, callback, next);
+        });
     }
 
     fm.sendTo(player);
 }
 
+void HomeOperatorGUI::sendSearchPlayerGUI(Player& player, ChoosePlayerCallback callback, PlayerPageState state) {
+    auto localeCode = TeleportSystem::getInstance().getSessionManager().getSession(player).getLocaleCode();
+
+    CustomForm fm{"Teleport System - Home Manager"_trl(localeCode)};
+    fm.appendInput("keyword", "玩家名 (留空显示全部): "_trl(localeCode), "string", state.keyword);
+    fm.appendDropdown(
+        "order",
+        "排序: "_trl(localeCode),
+        {"注册顺序"_trl(localeCode), "最近修改"_trl(localeCode)},
+        state.order == HomeStorage::PlayerOrder::ById ? 0 : 1
+    );
+
+    fm.sendTo(
+        player,
+        [callback = std::move(callback), localeCode](Player& self, ll::form::CustomFormResult const& result, auto) {
+            if (!result) {
+                return;
+            }
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(self)) {
+                limiter.sendRateLimitedMessage(self);
+                return;
+            }
+
+            PlayerPageState state;
+            state.keyword = std::get<std::string>(result->at("keyword"));
+            state.order   = std::get<std::string>(result->at("order")) == "注册顺序"_trl(localeCode)
+                              ? HomeStorage::PlayerOrder::ById
+                              : HomeStorage::PlayerOrder::LastModified;
+            sendChoosePlayerPage(self, callback, std::move(state));
+        }
+    );
+}
+
 void HomeOperatorGUI::sendChooseHomeGUI(Player& player, RealName targetPlayer, ChooseHomeCallback callback) {
     auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<HomeStorage>();
     if (!storage) {
@@ -159,6 +228,10 @@ void HomeOperatorGUI::sendCreateOrEditHomeGUI(
             if (!result) {
                 return;
             }
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(self)) {
+                limiter.sendRateLimitedMessage(self);
+                return;
+            }
 
             auto name = std::get<std::string>(result->at("name"));
 
@@ -1,8 +1,11 @@
 #pragma once
 #include "ltps/Global.h"
 #include "ltps/modules/home/HomeStorage.h"
+#include <cstddef>
 #include <functional>
 #include <optional>
+#include <string>
+#include <vector>
 
 
 class Player;
@@ -16,9 +19,22 @@ class HomeOperatorGUI {
 
     TPSAPI static void sendMainGUI(Player& player);
 
+    static inline constexpr std::size_t PlayerPageSize = 32; // 每页玩家数
+
+    // 玩家列表分页状态
+    struct PlayerPageState {
+        std::string                            keyword; // 玩家名搜索
+        HomeStorage::PlayerOrder               order{HomeStorage::PlayerOrder::ById};
+        std::vector<HomeStorage::PlayerCursor> cursors{{}}; // 已访问页的起始游标，back() 为当前页
+    };
+
     using ChoosePlayerCallback = std::function<void(Player& self, RealName realName)>;
     TPSAPI static void sendChoosePlayerGUI(Player& player, ChoosePlayerCallback callback);
 
+    TPSAPI static void sendChoosePlayerPage(Player& player, ChoosePlayerCallback callback, PlayerPageState state);
+
+    TPSAPI static void sendSearchPlayerGUI(Player& player, ChoosePlayerCallback callback, PlayerPageState state);
+
     using ChooseHomeCallback = std::function<void(Player& self, RealName targetPlayer, HomeStorage::Home home)>;
     TPSAPI static void sendChooseHomeGUI(Player& player, RealName targetPlayer, ChooseHomeCallback callback);
 
@@ -29,11 +29,7 @@ void SettingStorage::load() {
             throw std::runtime_error("Player settings is not an object");
         }
 
-        for (auto& [key, value] : json.items()) {
-            SettingData settingData{};
-            json_utils::json2structTryPatch(settingData, value);
-            mSettingDatas[key] = settingData;
-        }
+        mSettingDatas.fromJson(getPlayerRegistry(), json);
 
         TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} player settings", mSettingDatas.size());
     } catch (const nlohmann::json::parse_error& e) {
@@ -48,26 +44,29 @@ void SettingStorage::unload() {
 
 void SettingStorage::writeBack() {
     auto& database = getDatabase();
-    auto  json     = json_utils::struct2json(mSettingDatas);
+    auto  json     = mSettingDatas.toJson(getPlayerRegistry());
     database.set(STORAGE_KEY, json.dump());
 }
 
 Result<SettingData> SettingStorage::getSettingData(RealName const& realName) const {
-    if (auto it = mSettingDatas.find(realName); it != mSettingDatas.end()) {
-        return it->second;
+    return getSettingData(getPlayerRegistry().find(realName));
+}
+
+Result<SettingData> SettingStorage::getSettingData(PlayerId id) const {
+    if (auto data = mSettingDatas.find(id)) {
+        return *data;
     }
     return std::unexpected{"Player setting not found"};
 }
 
 void SettingStorage::initPlayerSetting(RealName const& realName) {
-    if (mSettingDatas.find(realName) == mSettingDatas.end()) {
-        mSettingDatas[realName] = SettingData{};
-    }
+    (void)mSettingDatas[getPlayerRegistry().getOrCreate(realName)]; // 不存在时默认构造
 }
 
 
 Result<void> SettingStorage::setSettingData(RealName const& realName, SettingData settingData) {
-    mSettingDatas[realName] = settingData;
+    mSettingDatas[getPlayerRegistry().getOrCreate(realName)] = settingData;
+    TeleportSystem::getInstance().getSessionManager().refreshSettings(realName);
     return {};
 }
 
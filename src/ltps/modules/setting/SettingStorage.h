@@ -1,8 +1,8 @@
 #pragma once
 #include "ltps/Global.h"
 #include "ltps/database/IStorage.h"
+#include "ltps/database/PlayerTable.h"
 #include <memory>
-#include <unordered_map>
 
 
 namespace ltps::setting {
@@ -25,10 +25,11 @@ class SettingStorage final : public IStorage {
     TPSAPI void writeBack() override;
 
 private:
-    std::unordered_map<RealName, SettingData> mSettingDatas; // realName -> SettingData
+    PlayerTable<SettingData> mSettingDatas; // PlayerId -> SettingData
 
 public:
     TPSNDAPI Result<SettingData> getSettingData(RealName const& realName) const;
+    TPSNDAPI Result<SettingData> getSettingData(PlayerId id) const;
 
     TPSNDAPI Result<void> setSettingData(RealName const& realName, SettingData settingData);
 
@@ -1,6 +1,7 @@
 #include "SettingGUI.h"
 
 #include "ltps/TeleportSystem.h"
+#include "ltps/common/RateLimiter.h"
 #include "ltps/modules/setting/SettingStorage.h"
 #include "ltps/utils/McUtils.h"
 
@@ -26,6 +27,10 @@ void SettingGUI::sendMainGUI(Player& player) {
 
     fm.sendTo(player, [](Player& self, ll::form::CustomFormResult const& res, auto) {
         if (!res) return;
+        if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(self)) {
+            limiter.sendRateLimitedMessage(self);
+            return;
+        }
 
         auto realName   = self.getRealName();
         auto localeCode = self.getLocaleCode();
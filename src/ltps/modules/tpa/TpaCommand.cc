@@ -70,7 +70,19 @@ void TpaCommand::setup() {
             }
 
             if (targets.size() > 1) {
-                mc_utils::sendText<mc_utils::Error>(output, "目标玩家过多"_trl(localeCode));
+                if (param.type != TpaRequest::Type::Here) {
+                    mc_utils::sendText<mc_utils::Error>(output, "目标玩家过多"_trl(localeCode));
+                    return;
+                }
+                // 批量召集：共享一次价格计算与一个过期计时，表单分帧发送
+                ll::event::EventBus::getInstance().publish(CreateTpaBatchRequestEvent{
+                    player,
+                    std::vector<Player*>{targets.data->begin(), targets.data->end()},
+                    param.type,
+                    [](std::vector<std::shared_ptr<TpaRequest>> const& requests) {
+                        TpaRequest::sendFormToReceivers(requests);
+                    }
+                });
                 return;
             }
 
@@ -5,6 +5,8 @@
 #include "ltps/TeleportSystem.h"
 #include "ltps/base/Config.h"
 #include "ltps/common/PriceCalculate.h"
+#include "ltps/common/RateLimiter.h"
+#include "ltps/database/PermissionStorage.h"
 #include "ltps/modules/tpa/TpaCommand.h"
 #include "ltps/modules/tpa/TpaRequest.h"
 #include "ltps/modules/tpa/event/TpaEvents.h"
@@ -32,6 +34,12 @@ bool TpaModule::enable() {
 
     mListeners.emplace_back(bus.emplaceListener<CreateTpaRequestEvent>(
         [this, &bus](CreateTpaRequestEvent& ev) {
+            auto& sender = ev.getSender();
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(sender)) {
+                limiter.sendRateLimitedMessage(sender);
+                return;
+            }
+
             auto before = CreatingTpaRequestEvent(ev);
             bus.publish(before);
 
@@ -50,54 +58,7 @@ bool TpaModule::enable() {
 
     mListeners.emplace_back(bus.emplaceListener<CreatingTpaRequestEvent>(
         [this](CreatingTpaRequestEvent& ev) {
-            auto& sender = ev.getSender();
-
-            auto localeCode = sender.getLocaleCode();
-
-            // 维度检查
-            if (std::find(
-                    getConfig().modules.tpa.disallowedDimensions.begin(),
-                    getConfig().modules.tpa.disallowedDimensions.end(),
-                    sender.getDimensionId()
-                )
-                != getConfig().modules.tpa.disallowedDimensions.end()) {
-                mc_utils::sendText<mc_utils::Error>(sender, "此功能在当前维度不可用"_trl(localeCode));
-                ev.cancel();
-                return;
-            }
-
-            // TPA 请求冷却
-            if (this->mCooldown.isCooldown(sender.getRealName())) {
-                mc_utils::sendText<mc_utils::Error>(
-                    sender,
-                    "TPA 请求冷却中，剩余时间 {0}"_trl(
-                        localeCode,
-                        this->mCooldown.getCooldownString(sender.getRealName())
-                    )
-                );
-                ev.cancel();
-                return;
-            }
-            this->mCooldown.setCooldown(sender.getRealName(), getConfig().modules.tpa.cooldownTime);
-
-            // 费用检查
-            PriceCalculate cl(getConfig().modules.tpa.createRequestCalculate);
-            auto           clValue = cl.eval();
-            if (!clValue.has_value()) {
-                TeleportSystem::getInstance().getSelf().getLogger().error(
-                    "An exception occurred while calculating the TPA price, please check the configuration file.\n{}",
-                    clValue.error()
-                );
-                mc_utils::sendText<mc_utils::Error>(sender, "TPA 模块异常，请联系管理员"_trl(localeCode));
-                ev.cancel();
-                return;
-            }
-
-            auto price = static_cast<llong>(*clValue);
-
-            auto economy = EconomySystemManager::getInstance().getEconomySystem();
-            if (!economy->reduce(sender, price)) {
-                economy->sendNotEnoughMoneyMessage(sender, price, localeCode);
+            if (!checkCreateRequest(ev.getSender(), 1)) {
                 ev.cancel();
             }
         },
@@ -123,6 +84,97 @@ bool TpaModule::enable() {
         ll::event::EventPriority::High
     ));
 
+    mListeners.emplace_back(bus.emplaceListener<CreateTpaBatchRequestEvent>(
+        [this, &bus](CreateTpaBatchRequestEvent& ev) {
+            auto& sender  = ev.getSender();
+            auto& session = TeleportSystem::getInstance().getSessionManager().getSession(sender);
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(sender)) {
+                limiter.sendRateLimitedMessage(sender);
+                return;
+            }
+
+            // 先排除自身、重复与已有请求的接收者，再按剩余人数收费
+            auto receivers = getRequestPool().filterBatchReceivers(sender, ev.getReceivers());
+            if (receivers.empty()) {
+                mc_utils::sendText<mc_utils::Error>(
+                    sender,
+                    "没有可以发起请求的玩家 (已排除自己与已有请求的玩家)"_trl(session.getLocaleCode())
+                );
+                return;
+            }
+
+            auto before = CreatingTpaBatchRequestEvent(ev, std::move(receivers));
+            bus.publish(before);
+
+            if (before.isCancelled()) {
+                return;
+            }
+
+            auto requests = getRequestPool().createBatchRequest(sender, before.getReceivers(), ev.getType());
+
+            ev.invokeCallback(requests);
+
+            bus.publish(CreatedTpaBatchRequestEvent(std::move(requests)));
+        },
+        ll::event::EventPriority::High
+    ));
+
+    mListeners.emplace_back(bus.emplaceListener<CreatingTpaBatchRequestEvent>(
+        [this](CreatingTpaBatchRequestEvent& ev) {
+            auto& sender  = ev.getSender();
+            auto& session = TeleportSystem::getInstance().getSessionManager().getSession(sender);
+
+            if (!session.hasPermission(PermissionStorage::Permission::BroadcastTpa)) {
+                mc_utils::sendText<mc_utils::Error>(
+                    sender,
+                    "你没有权限发起批量 Tpa 请求"_trl(session.getLocaleCode())
+                );
+                ev.cancel();
+                return;
+            }
+
+            if (!checkCreateRequest(sender, ev.getReceivers().size())) {
+                ev.cancel();
+            }
+        },
+        ll::event::EventPriority::High
+    ));
+
+    mListeners.emplace_back(bus.emplaceListener<CreatedTpaBatchRequestEvent>(
+        [](CreatedTpaBatchRequestEvent& ev) {
+            auto& requests = ev.getRequests();
+            if (requests.empty()) {
+                return;
+            }
+            auto& sessions = TeleportSystem::getInstance().getSessionManager();
+            auto  sender   = requests.front()->getSender();
+            auto  type     = TpaRequest::getTypeString(requests.front()->getType());
+
+            RealName senderName;
+            if (sender) {
+                auto& session = sessions.getSession(*sender);
+                senderName    = session.getRealName();
+                mc_utils::sendText(
+                    *sender,
+                    "已向 {0} 名玩家发起 '{1}' 请求"_trl(session.getLocaleCode(), requests.size(), type)
+                );
+            }
+            for (auto const& request : requests) {
+                if (auto receiver = request->getReceiver()) {
+                    mc_utils::sendText(
+                        *receiver,
+                        "收到来自 '{0}' 的 '{1}' 请求"_trl(
+                            sessions.getSession(*receiver).getLocaleCode(),
+                            senderName,
+                            type
+                        )
+                    );
+                }
+            }
+        },
+        ll::event::EventPriority::High
+    ));
+
     mListeners.emplace_back(bus.emplaceListener<PlayerExecuteTpaCommandEvent>(
         [this](PlayerExecuteTpaCommandEvent& ev) { handlePlayerExecuteTpaCommand(ev); },
         ll::event::EventPriority::High
@@ -130,6 +182,10 @@ bool TpaModule::enable() {
 
     mListeners.emplace_back(bus.emplaceListener<TpaRequestExpiredEvent>([](TpaRequestExpiredEvent& ev) {
         auto& req = ev.getRequest();
+        if (req->isBatch()) {
+            req->notifyReceiverExpired(); // 批量请求只通知接收者，避免发起者被刷屏
+            return;
+        }
         if (req->isSenderAndReceiverOnline()) {
             req->notifyExpired(); // 通知双方请求已过期
         }
@@ -158,9 +214,63 @@ TpaRequestPool&       TpaModule::getRequestPool() { return *mTpaRequestPool; }
 TpaRequestPool const& TpaModule::getRequestPool() const { return *mTpaRequestPool; }
 
 
+bool TpaModule::checkCreateRequest(Player& sender, size_t count) {
+    auto& session    = TeleportSystem::getInstance().getSessionManager().getSession(sender);
+    auto& localeCode = session.getLocaleCode();
+
+    // 维度检查
+    if (std::find(
+            getConfig().modules.tpa.disallowedDimensions.begin(),
+            getConfig().modules.tpa.disallowedDimensions.end(),
+            sender.getDimensionId()
+        )
+        != getConfig().modules.tpa.disallowedDimensions.end()) {
+        mc_utils::sendText<mc_utils::Error>(sender, "此功能在当前维度不可用"_trl(localeCode));
+        return false;
+    }
+
+    // TPA 请求冷却
+    if (this->mCooldown.isCooldown(session.getCooldownId())) {
+        mc_utils::sendText<mc_utils::Error>(
+            sender,
+            "TPA 请求冷却中，剩余时间 {0}"_trl(localeCode, this->mCooldown.getCooldownString(session.getCooldownId()))
+        );
+        return false;
+    }
+    this->mCooldown.setCooldown(session.getCooldownId(), getConfig().modules.tpa.cooldownTime);
+
+    // 费用检查
+    PriceCalculate cl(getConfig().modules.tpa.createRequestCalculate);
+    cl.addVariable("count", static_cast<double>(count));
+    auto clValue = cl.eval();
+    if (!clValue.has_value()) {
+        TeleportSystem::getInstance().getSelf().getLogger().error(
+            "An exception occurred while calculating the TPA price, please check the configuration file.\n{}",
+            clValue.error()
+        );
+        mc_utils::sendText<mc_utils::Error>(sender, "TPA 模块异常，请联系管理员"_trl(localeCode));
+        return false;
+    }
+
+    auto price = static_cast<llong>(*clValue);
+
+    auto economy = EconomySystemManager::getInstance().getEconomySystem();
+    if (!economy->reduce(sender, price)) {
+        economy->sendNotEnoughMoneyMessage(sender, price, localeCode);
+        return false;
+    }
+    return true;
+}
+
 void TpaModule::handlePlayerExecuteTpaCommand(PlayerExecuteTpaCommandEvent& ev) {
     auto&      receiver   = ev.getPlayer();
-    auto const localeCode = receiver.getLocaleCode();
+    auto&      session    = TeleportSystem::getInstance().getSessionManager().getSession(receiver);
+    auto const localeCode = session.getLocaleCode();
+
+    if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(receiver)) {
+        limiter.sendRateLimitedMessage(receiver);
+        return;
+    }
 
     if (receiver.isSleeping()) {
         mc_utils::sendText<mc_utils::Error>(receiver, "你不能在睡觉时使用此命令"_trl(localeCode));
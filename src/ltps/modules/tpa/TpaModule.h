@@ -11,7 +11,7 @@ namespace ltps::tpa {
 
 
 class TpaModule final : public IModule {
-    Cooldown mCooldown;
+    Cooldown mCooldown{CooldownTable::Column::Tpa};
 
     std::unique_ptr<TpaRequestPool> mTpaRequestPool;
 
@@ -44,6 +44,9 @@ class TpaModule final : public IModule {
     void handlePlayerExecuteTpaCommand(class PlayerExecuteTpaCommandEvent& ev);
     void handleAcceptOrDenyTpaRequest(Player& receiver, bool accept);
     void handleCancelTpaRequest(Player& sender);
+
+    // 创建请求前的通用检查（维度、冷却、费用），count 为本次请求的目标数量
+    bool checkCreateRequest(Player& sender, size_t count);
 };
 
 
@@ -1,9 +1,11 @@
 #include "ltps/modules/tpa/TpaRequest.h"
-#include "../setting/SettingStorage.h"
 #include "fmt/core.h"
+#include "ll/api/chrono/GameChrono.h"
+#include "ll/api/coro/CoroTask.h"
 #include "ll/api/event/EventBus.h"
 #include "ll/api/form/SimpleForm.h"
 #include "ll/api/i18n/I18n.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
 #include "ltps/TeleportSystem.h"
 #include "ltps/base/Config.h"
 #include "ltps/common/EconomySystem.h"
@@ -15,8 +17,10 @@
 #include "mc/deps/ecs/WeakEntityRef.h"
 #include "mc/platform/UUID.h"
 #include "mc/world/actor/player/Player.h"
+#include <algorithm>
 #include <chrono>
 #include <memory>
+#include <vector>
 
 
 namespace ltps::tpa {
@@ -31,8 +35,9 @@ struct TpaRequest::Impl {
     State                  mState;
     SystemTime             mCreationTime;   // 请求创建时间
     SteadyTime             mExpirationTime; // 请求失效时间
+    bool                   mIsBatch;        // 是否属于批量请求
 
-    explicit Impl(Player& sender, Player& receiver, Type type)
+    explicit Impl(Player& sender, Player& receiver, Type type, SteadyTime expireTime, bool isBatch)
     : mSender(sender.getWeakEntity()),
       mReceiver(receiver.getWeakEntity()),
       mSenderUUID(sender.getUuid()),
@@ -40,13 +45,22 @@ struct TpaRequest::Impl {
       mType(type),
       mState(State::Available),
       mCreationTime(time_utils::now()),
-      mExpirationTime(std::chrono::steady_clock::now() + std::chrono::seconds(getConfig().modules.tpa.expirationTime)) {
-    }
+      mExpirationTime(expireTime),
+      mIsBatch(isBatch) {}
 };
 
 
 TpaRequest::TpaRequest(Player& sender, Player& receiver, Type type)
-: mImpl(std::make_unique<Impl>(sender, receiver, type)) {}
+: TpaRequest(
+      sender,
+      receiver,
+      type,
+      std::chrono::steady_clock::now() + std::chrono::seconds(getConfig().modules.tpa.expirationTime),
+      false
+  ) {}
+
+TpaRequest::TpaRequest(Player& sender, Player& receiver, Type type, SteadyTime expireTime, bool isBatch)
+: mImpl(std::make_unique<Impl>(sender, receiver, type, expireTime, isBatch)) {}
 TpaRequest::~TpaRequest() = default;
 
 Player*          TpaRequest::getSender() const { return mImpl->mSender.tryUnwrap<Player>().as_ptr(); }
@@ -74,11 +88,18 @@ std::string TpaRequest::getExpirationTime() const {
 
 TpaRequest::SteadyTime const& TpaRequest::getExpireTime() const { return mImpl->mExpirationTime; }
 
+bool TpaRequest::isBatch() const { return mImpl->mIsBatch; }
+
 bool TpaRequest::tryUpdateState(State state) {
     if (mImpl->mState == State::Available || mImpl->mState == state) {
         mImpl->mState = state; // 状态不可逆，只允许从Available状态转换
         return true;
     }
+    if (mImpl->mState == State::Teleporting
+        && (state == State::Accepted || state == State::SenderOffline || state == State::ReceiverOffline)) {
+        mImpl->mState = state; // 排队中的传送完成或失败
+        return true;
+    }
     return false;
 }
 
@@ -127,22 +148,46 @@ void TpaRequest::accept() {
 
     auto sender   = getSender();
     auto receiver = getReceiver();
-
-    switch (mImpl->mType) {
-    case Type::To: {
-        sender->teleport(receiver->getPosition(), receiver->getDimensionId(), mc_utils::getRotation(*sender));
-        break;
-    }
-    case Type::Here: {
-        receiver->teleport(sender->getPosition(), sender->getDimensionId(), mc_utils::getRotation(*receiver));
-        break;
-    }
-    }
-
-    tryUpdateState(State::Accepted);
-    notifyAccepted();
-
-    bus.publish(TpaRequestAcceptedEvent(shared_from_this()));
+    auto mover    = mImpl->mType == Type::To ? sender : receiver; // 被传送的玩家
+    auto target   = mImpl->mType == Type::To ? receiver : sender;
+
+    tryUpdateState(State::Teleporting); // 立即标记，排队期间不能再次接受 / 拒绝
+
+    // 出队时按目标玩家当前位置传送；排队期间任一方离线时由离线监听转为离线状态并通知另一方
+    TeleportSystem::getInstance().getTeleportDispatcher().dispatch(
+        *mover,
+        target->getDimensionId(),
+        [request = shared_from_this()](Player& self) {
+            if (request->getState() != State::Teleporting) {
+                return; // 排队期间目标玩家离线，已通知
+            }
+            auto isTo   = request->getType() == Type::To;
+            auto target = isTo ? request->getReceiver() : request->getSender();
+            if (!target) {
+                request->tryUpdateState(isTo ? State::ReceiverOffline : State::SenderOffline);
+                request->_notifyState(&self);
+                return;
+            }
+            self.teleport(target->getPosition(), target->getDimensionId(), mc_utils::getRotation(self));
+
+            request->tryUpdateState(State::Accepted);
+            request->notifyAccepted();
+            ll::event::EventBus::getInstance().publish(TpaRequestAcceptedEvent(request));
+        },
+        [request = shared_from_this()]() {
+            if (request->getState() != State::Teleporting) {
+                return;
+            }
+            // 被传送的玩家离线或队列被清空
+            if (request->getType() == Type::To) {
+                request->tryUpdateState(State::SenderOffline);
+                request->notifySenderOffline();
+            } else {
+                request->tryUpdateState(State::ReceiverOffline);
+                request->notifyReceiverOffline();
+            }
+        }
+    );
 }
 
 void TpaRequest::deny() {
@@ -185,11 +230,10 @@ void TpaRequest::sendFormToReceiver() {
     auto receiver = getReceiver();
     auto sender   = getSender();
 
-    auto& settingStorage     = *TeleportSystem::getInstance().getStorageManager().getStorage<setting::SettingStorage>();
-    auto  receiverSettings   = settingStorage.getSettingData(receiver->getRealName()).value();
-    auto  receiverLocaleCode = receiver->getLocaleCode();
+    auto& receiverSession    = TeleportSystem::getInstance().getSessionManager().getSession(*receiver);
+    auto& receiverLocaleCode = receiverSession.getLocaleCode();
 
-    if (!receiverSettings.tpaPopup) {
+    if (!receiverSession.getSettings().tpaPopup) {
         return; // 玩家不接受 tpa 弹窗
     }
 
@@ -272,11 +316,32 @@ void TpaRequest::notifyCancelled() const {
     _notifyState(getSender());
 }
 
+void TpaRequest::sendFormToReceivers(std::vector<std::shared_ptr<TpaRequest>> requests) {
+    if (requests.empty()) {
+        return;
+    }
+    ll::coro::keepThis([requests = std::move(requests)]() -> ll::coro::CoroTask<> {
+        auto const perTick = static_cast<size_t>(std::max(getConfig().modules.tpa.batchFormsPerTick, 1));
+
+        size_t sent = 0;
+        for (auto const& request : requests) {
+            if (sent != 0 && sent % perTick == 0) {
+                co_await ll::chrono::ticks(1);
+            }
+            request->sendFormToReceiver(); // 内部会刷新状态，已失效的请求直接跳过
+            ++sent;
+        }
+        co_return;
+    }).launch(ll::thread::ServerThreadExecutor::getDefault());
+}
+
 void TpaRequest::notifyExpired() const {
     _notifyState(getReceiver());
     _notifyState(getSender());
 }
 
+void TpaRequest::notifyReceiverExpired() const { _notifyState(getReceiver()); }
+
 void TpaRequest::notifySenderOffline() const { _notifyState(getReceiver()); }
 
 void TpaRequest::notifyReceiverOffline() const { _notifyState(getSender()); }
@@ -303,6 +368,8 @@ std::string TpaRequest::getStateDescription(State state, std::string const& loca
         return "接收者离线"_trl(localeCode);
     case State::Cancelled:
         return "请求已取消"_trl(localeCode);
+    case State::Teleporting:
+        return "请求已接受，等待传送"_trl(localeCode);
     default:
         return "未知状态"_trl(localeCode);
     }
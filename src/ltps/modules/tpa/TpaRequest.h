@@ -3,6 +3,7 @@
 #include "mc/platform/UUID.h"
 #include <chrono>
 #include <memory>
+#include <vector>
 
 
 class Player;
@@ -25,6 +26,7 @@ class TpaRequest final : public std::enable_shared_from_this<TpaRequest> {
         ReceiverOffline, // 接收者离线
         Expired,         // 请求已过期
         Cancelled,       // 请求已取消
+        Teleporting,     // 已接受，等待传送（排队中），之后转为 Accepted 或离线状态
     };
 
     using SystemTime = std::chrono::system_clock::time_point;
@@ -34,6 +36,9 @@ class TpaRequest final : public std::enable_shared_from_this<TpaRequest> {
 
     TPSAPI explicit TpaRequest(Player& sender, Player& receiver, Type type);
 
+    // 批量请求使用，同一批次共享过期时间
+    TPSAPI explicit TpaRequest(Player& sender, Player& receiver, Type type, SteadyTime expireTime, bool isBatch);
+
     TPSAPI ~TpaRequest();
 
     TPSNDAPI Player* getSender() const;
@@ -58,9 +63,13 @@ class TpaRequest final : public std::enable_shared_from_this<TpaRequest> {
 
     TPSNDAPI SteadyTime const& getExpireTime() const;
 
+    // 是否属于批量请求 (一对多 tpahere)
+    TPSNDAPI bool isBatch() const;
+
+    // 状态只能从 Available 转出；Teleporting 只能转为 Accepted 或离线状态
     TPSAPI bool tryUpdateState(State state);
 
-    TPSAPI bool isFinalState() const;
+    TPSAPI bool isFinalState() const; // Teleporting 也视为已处理（不再过期）
 
     TPSNDAPI bool isExpired() const;
 
@@ -82,6 +91,12 @@ class TpaRequest final : public std::enable_shared_from_this<TpaRequest> {
 
     TPSAPI void sendFormToReceiver();
 
+    /**
+     * @brief 分帧向多个接收者发送表单（批量请求）
+     * 每 tick 最多发送 tpa.batchFormsPerTick 个表单，避免大批量召集时单 tick 卡顿
+     */
+    TPSAPI static void sendFormToReceivers(std::vector<std::shared_ptr<TpaRequest>> requests);
+
     TPSAPI void notifyAccepted() const;
 
     TPSAPI void notifyDenied() const;
@@ -90,6 +105,8 @@ class TpaRequest final : public std::enable_shared_from_this<TpaRequest> {
 
     TPSAPI void notifyExpired() const;
 
+    TPSAPI void notifyReceiverExpired() const;
+
     TPSAPI void notifySenderOffline() const;
 
     TPSAPI void notifyReceiverOffline() const;
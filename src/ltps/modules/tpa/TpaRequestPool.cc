@@ -1,4 +1,5 @@
 #include "ltps/modules/tpa/TpaRequestPool.h"
+#include "ltps/base/Config.h"
 #include "ltps/common/TimeScheduler.h"
 #include "ltps/modules/tpa/TpaRequest.h"
 #include "ltps/modules/tpa/event/TpaEvents.h"
@@ -14,6 +15,7 @@
 #include "mc/platform/UUID.h"
 #include "mc/world/actor/player/Player.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -25,14 +27,22 @@
 namespace ltps::tpa {
 
 
+// 调度器条目，同一批次的请求共享一个过期计时
+struct ExpireEntry {
+    TpaRequest::SteadyTime                   mExpireTime;
+    std::vector<std::shared_ptr<TpaRequest>> mRequests;
+
+    TpaRequest::SteadyTime getExpireTime() const { return mExpireTime; }
+};
+
 struct Compare {
-    bool operator()(std::shared_ptr<TpaRequest> const& lhs, std::shared_ptr<TpaRequest> const& rhs) const {
+    bool operator()(std::shared_ptr<ExpireEntry> const& lhs, std::shared_ptr<ExpireEntry> const& rhs) const {
         return lhs->getExpireTime() > rhs->getExpireTime();
     }
 };
 
 struct TpaRequestPool::Impl {
-    TimeScheduler<TpaRequest, Compare> mRequestScheduler;
+    TimeScheduler<ExpireEntry, Compare> mRequestScheduler;
 
     using RequestQueryMap = std::unordered_map<mce::UUID, std::unordered_map<mce::UUID, std::shared_ptr<TpaRequest>>>;
     RequestQueryMap mForwardMap; // Receiver -> [Sender] -> Request
@@ -51,10 +61,24 @@ struct TpaRequestPool::Impl {
         auto& receiver = request->getReceiverUUID();
         {
             std::unique_lock lock{mMutex};
-            mRequestScheduler.add(request);
+            mRequestScheduler.add(std::make_shared<ExpireEntry>(request->getExpireTime(), std::vector{request}));
+            mForwardMap[receiver][sender] = request;
+            mReverseMap[sender][receiver] = request;
+        }
+    }
+
+    void addBatchRequestImpl(std::vector<std::shared_ptr<TpaRequest>> const& requests) {
+        if (requests.empty()) {
+            return;
+        }
+        std::unique_lock lock{mMutex};
+        for (auto const& request : requests) {
+            auto& sender                  = request->getSenderUUID();
+            auto& receiver                = request->getReceiverUUID();
             mForwardMap[receiver][sender] = request;
             mReverseMap[sender][receiver] = request;
         }
+        mRequestScheduler.add(std::make_shared<ExpireEntry>(requests.front()->getExpireTime(), requests));
     }
 
     bool hasRequestImpl(mce::UUID const& sender, mce::UUID const& receiver) {
@@ -140,13 +164,24 @@ struct TpaRequestPool::Impl {
     }
 
     explicit Impl() {
-        mRequestScheduler.setExpireCallback([](std::shared_ptr<TpaRequest> const& req) {
-            if (req->isFinalState() && req->getState() != TpaRequest::State::Expired) {
-                return; // 请求已经处理过，不再处理
+        mRequestScheduler.setExpireCallback([](std::shared_ptr<ExpireEntry> const& entry) {
+            std::vector<std::shared_ptr<TpaRequest>> expired;
+            expired.reserve(entry->mRequests.size());
+            for (auto const& req : entry->mRequests) {
+                if (req->isFinalState() && req->getState() != TpaRequest::State::Expired) {
+                    continue; // 请求已经处理过，不再处理
+                }
+                req->tryUpdateState(TpaRequest::State::Expired);
+                expired.push_back(req);
+            }
+            if (expired.empty()) {
+                return;
             }
-            req->tryUpdateState(TpaRequest::State::Expired);
-            ll::coro::keepThis([req]() -> ll::coro::CoroTask<> {
-                ll::event::EventBus::getInstance().publish(TpaRequestExpiredEvent{req});
+            ll::coro::keepThis([expired = std::move(expired)]() -> ll::coro::CoroTask<> {
+                auto& bus = ll::event::EventBus::getInstance();
+                for (auto const& req : expired) {
+                    bus.publish(TpaRequestExpiredEvent{req});
+                }
                 co_return;
             }).launch(ll::thread::ServerThreadExecutor::getDefault());
         });
@@ -195,6 +230,35 @@ std::shared_ptr<TpaRequest> TpaRequestPool::createRequest(Player& sender, Player
     return req;
 }
 
+std::vector<std::shared_ptr<TpaRequest>>
+TpaRequestPool::createBatchRequest(Player& sender, std::vector<Player*> const& receivers, TpaRequest::Type type) {
+    auto const expireTime =
+        std::chrono::steady_clock::now() + std::chrono::seconds(getConfig().modules.tpa.expirationTime);
+
+    auto filtered = filterBatchReceivers(sender, receivers);
+
+    std::vector<std::shared_ptr<TpaRequest>> requests;
+    requests.reserve(filtered.size());
+    for (auto* receiver : filtered) {
+        requests.push_back(std::make_shared<TpaRequest>(sender, *receiver, type, expireTime, true));
+    }
+    mImpl->addBatchRequestImpl(requests);
+    return requests;
+}
+
+std::vector<Player*> TpaRequestPool::filterBatchReceivers(Player& sender, std::vector<Player*> const& receivers) {
+    std::vector<Player*> result;
+    result.reserve(receivers.size());
+    for (auto* receiver : receivers) {
+        if (!receiver || receiver == &sender || hasRequest(sender, *receiver)
+            || std::find(result.begin(), result.end(), receiver) != result.end()) {
+            continue;
+        }
+        result.push_back(receiver);
+    }
+    return result;
+}
+
 bool TpaRequestPool::hasRequest(mce::UUID const& sender, mce::UUID const& receiver) {
     return mImpl->hasRequestImpl(sender, receiver);
 }
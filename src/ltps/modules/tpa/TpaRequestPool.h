@@ -21,6 +21,16 @@ class TpaRequestPool {
 public:
     TPSNDAPI std::shared_ptr<TpaRequest> createRequest(Player& sender, Player& receiver, TpaRequest::Type type);
 
+    /**
+     * @brief 创建批量请求（一对多），所有请求共享一个过期计时
+     * 会跳过发起者自身以及已存在请求的接收者
+     */
+    TPSNDAPI std::vector<std::shared_ptr<TpaRequest>>
+             createBatchRequest(Player& sender, std::vector<Player*> const& receivers, TpaRequest::Type type);
+
+    // 过滤批量请求的接收者：去除空指针、发起者自身、重复玩家以及已存在请求的接收者
+    TPSNDAPI std::vector<Player*> filterBatchReceivers(Player& sender, std::vector<Player*> const& receivers);
+
     TPSNDAPI bool hasRequest(mce::UUID const& sender, mce::UUID const& receiver);
     TPSNDAPI bool hasRequest(Player& sender, Player& receiver);
 
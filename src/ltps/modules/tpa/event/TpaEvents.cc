@@ -46,6 +46,58 @@ CreatedTpaRequestEvent::CreatedTpaRequestEvent(std::shared_ptr<TpaRequest> reque
 std::shared_ptr<TpaRequest> CreatedTpaRequestEvent::getRequest() const { return mRequest; }
 
 
+// ICreateTpaBatchRequestEvent
+ICreateTpaBatchRequestEvent::ICreateTpaBatchRequestEvent(
+    Player&              sender,
+    std::vector<Player*> receivers,
+    TpaRequest::Type     type
+)
+: mSender(sender),
+  mReceivers(std::move(receivers)),
+  mType(type) {}
+
+Player& ICreateTpaBatchRequestEvent::getSender() const { return mSender; }
+
+std::vector<Player*> const& ICreateTpaBatchRequestEvent::getReceivers() const { return mReceivers; }
+
+TpaRequest::Type ICreateTpaBatchRequestEvent::getType() const { return mType; }
+
+
+// CreateTpaBatchRequestEvent
+CreateTpaBatchRequestEvent::CreateTpaBatchRequestEvent(
+    Player&              sender,
+    std::vector<Player*> receivers,
+    TpaRequest::Type     type,
+    Callback             callback
+)
+: ICreateTpaBatchRequestEvent(sender, std::move(receivers), type),
+  mCallback(std::move(callback)) {}
+
+void CreateTpaBatchRequestEvent::invokeCallback(std::vector<std::shared_ptr<TpaRequest>> const& requests) const {
+    if (mCallback) {
+        mCallback(requests);
+    }
+}
+
+
+// CreatingTpaBatchRequestEvent
+CreatingTpaBatchRequestEvent::CreatingTpaBatchRequestEvent(CreateTpaBatchRequestEvent const& event)
+: ICreateTpaBatchRequestEvent(event.getSender(), event.getReceivers(), event.getType()) {}
+
+CreatingTpaBatchRequestEvent::CreatingTpaBatchRequestEvent(
+    CreateTpaBatchRequestEvent const& event,
+    std::vector<Player*>              receivers
+)
+: ICreateTpaBatchRequestEvent(event.getSender(), std::move(receivers), event.getType()) {}
+
+
+// CreatedTpaBatchRequestEvent
+CreatedTpaBatchRequestEvent::CreatedTpaBatchRequestEvent(std::vector<std::shared_ptr<TpaRequest>> requests)
+: mRequests(std::move(requests)) {}
+
+std::vector<std::shared_ptr<TpaRequest>> const& CreatedTpaBatchRequestEvent::getRequests() const { return mRequests; }
+
+
 // IAcceptOrDenyTpaRequestEvent
 IOperationTpaRequestEvent::IOperationTpaRequestEvent(std::shared_ptr<TpaRequest> const& request) : mRequest(request) {}
 
@@ -86,6 +138,9 @@ PlayerExecuteTpaCommandEvent::Action PlayerExecuteTpaCommandEvent::getAction() c
 IMPL_EVENT_EMITTER(CreateTpaRequestEvent);
 IMPL_EVENT_EMITTER(CreatingTpaRequestEvent);
 IMPL_EVENT_EMITTER(CreatedTpaRequestEvent);
+IMPL_EVENT_EMITTER(CreateTpaBatchRequestEvent);
+IMPL_EVENT_EMITTER(CreatingTpaBatchRequestEvent);
+IMPL_EVENT_EMITTER(CreatedTpaBatchRequestEvent);
 IMPL_EVENT_EMITTER(TpaRequestAcceptingEvent);
 IMPL_EVENT_EMITTER(TpaRequestAcceptedEvent);
 IMPL_EVENT_EMITTER(TpaRequestDenyingEvent);
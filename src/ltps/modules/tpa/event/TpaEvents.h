@@ -5,6 +5,7 @@
 #include "ltps/modules/tpa/TpaRequest.h"
 #include <functional>
 #include <memory>
+#include <vector>
 
 
 class Player;
@@ -70,6 +71,69 @@ class CreatedTpaRequestEvent final : public Event {
 };
 
 
+class ICreateTpaBatchRequestEvent {
+protected:
+    Player&              mSender;
+    std::vector<Player*> mReceivers;
+    TpaRequest::Type     mType;
+
+public:
+    TPSAPI explicit ICreateTpaBatchRequestEvent(Player& sender, std::vector<Player*> receivers, TpaRequest::Type type);
+
+    TPSNDAPI Player& getSender() const;
+
+    TPSNDAPI std::vector<Player*> const& getReceivers() const;
+
+    TPSNDAPI TpaRequest::Type getType() const;
+};
+
+
+/**
+ * @brief 创建批量 TPA 请求事件（一对多，如活动召集）
+ *  所有请求共享一次价格计算与一个过期计时
+ *  流程: CreateTpaBatchRequestEvent -> 过滤接收者 -> CreatingTpaBatchRequestEvent ->
+ *  TpaRequestPool::createBatchRequest() -> CreatedTpaBatchRequestEvent
+ */
+class CreateTpaBatchRequestEvent final : public ICreateTpaBatchRequestEvent, public Event {
+    using Callback = std::function<void(std::vector<std::shared_ptr<TpaRequest>> const& requests)>;
+    Callback mCallback;
+
+public:
+    TPSAPI explicit CreateTpaBatchRequestEvent(
+        Player&              sender,
+        std::vector<Player*> receivers,
+        TpaRequest::Type     type,
+        Callback             callback = {}
+    );
+
+    TPSAPI void invokeCallback(std::vector<std::shared_ptr<TpaRequest>> const& requests) const;
+};
+
+
+// 正在创建批量 TPA 请求事件
+class CreatingTpaBatchRequestEvent final : public ICreateTpaBatchRequestEvent, public Cancellable<Event> {
+public:
+    TPSAPI explicit CreatingTpaBatchRequestEvent(CreateTpaBatchRequestEvent const& event);
+
+    // receivers 为过滤后的接收者（费用按其数量计算）
+    TPSAPI explicit CreatingTpaBatchRequestEvent(
+        CreateTpaBatchRequestEvent const& event,
+        std::vector<Player*>              receivers
+    );
+};
+
+
+// 批量 TPA 请求创建完毕事件
+class CreatedTpaBatchRequestEvent final : public Event {
+    std::vector<std::shared_ptr<TpaRequest>> mRequests;
+
+public:
+    TPSAPI explicit CreatedTpaBatchRequestEvent(std::vector<std::shared_ptr<TpaRequest>> requests);
+
+    TPSNDAPI std::vector<std::shared_ptr<TpaRequest>> const& getRequests() const;
+};
+
+
 class IOperationTpaRequestEvent {
 protected:
     std::shared_ptr<TpaRequest> mRequest;
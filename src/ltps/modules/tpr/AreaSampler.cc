@@ -0,0 +1,99 @@
+#include "ltps/modules/tpr/AreaSampler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+
+namespace ltps::tpr {
+
+
+std::mt19937_64& AreaSampler::getEngine() {
+    thread_local std::mt19937_64 engine{[] {
+        std::random_device rd;
+        return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+    }()};
+    return engine;
+}
+
+int AreaSampler::randomInt(int min, int max) {
+    if (min > max) std::swap(min, max);
+    return std::uniform_int_distribution<int>{min, max}(getEngine());
+}
+
+std::pair<int, int> AreaSampler::sample(Area const& area) {
+    if (area.shape == Shape::Range) {
+        return {randomInt(area.rangeMin, area.rangeMax), randomInt(area.rangeMin, area.rangeMax)};
+    }
+
+    auto const maxRadius = std::max(area.maxRadius, 0);
+    auto const minRadius = std::clamp(area.minRadius, 0, maxRadius);
+
+    if (area.shape == Shape::Circle) {
+        // 半径按面积均匀分布：r = sqrt(U * (R² - r²) + r²)
+        auto&      engine = getEngine();
+        auto const r2Min  = static_cast<double>(minRadius) * minRadius;
+        auto const r2Max  = static_cast<double>(maxRadius) * maxRadius;
+        auto const radius = std::sqrt(std::uniform_real_distribution<double>{r2Min, r2Max}(engine));
+        auto const theta  = std::uniform_real_distribution<double>{0.0, 2.0 * std::numbers::pi}(engine);
+        return {
+            area.centerX + static_cast<int>(std::lround(radius * std::cos(theta))),
+            area.centerZ + static_cast<int>(std::lround(radius * std::sin(theta)))
+        };
+    }
+
+    if (minRadius == 0) {
+        return {area.centerX + randomInt(-maxRadius, maxRadius), area.centerZ + randomInt(-maxRadius, maxRadius)};
+    }
+
+    // 方形环拆为上下两条（整宽）与左右两条（内框高度），按面积选择后在其中均匀采样
+    auto const band  = static_cast<long long>(maxRadius - minRadius + 1);
+    auto const outer = 2LL * maxRadius + 1;
+    auto const inner = 2LL * minRadius - 1;
+    auto const pick  = std::uniform_int_distribution<long long>{0, 2 * band * (outer + inner) - 1}(getEngine());
+
+    auto const offset = randomInt(minRadius, maxRadius) * (randomInt(0, 1) == 0 ? -1 : 1); // 环带内的距离
+    if (pick < 2 * band * outer) {
+        return {area.centerX + randomInt(-maxRadius, maxRadius), area.centerZ + offset};
+    }
+    return {area.centerX + offset, area.centerZ + randomInt(-(minRadius - 1), minRadius - 1)};
+}
+
+bool AreaSampler::contains(Area const& area, int x, int z) {
+    if (area.shape == Shape::Range) {
+        return x >= area.rangeMin && x <= area.rangeMax && z >= area.rangeMin && z <= area.rangeMax;
+    }
+    auto dx = static_cast<long long>(x) - area.centerX;
+    auto dz = static_cast<long long>(z) - area.centerZ;
+    if (area.shape == Shape::Circle) {
+        auto d2 = dx * dx + dz * dz;
+        return d2 <= static_cast<long long>(area.maxRadius) * area.maxRadius
+            && d2 >= static_cast<long long>(area.minRadius) * area.minRadius;
+    }
+    auto d = std::max(std::abs(dx), std::abs(dz));
+    return d <= area.maxRadius && d >= area.minRadius;
+}
+
+bool AreaSampler::isExcluded(int x, int z, std::vector<ExclusionZone> const& zones) {
+    return std::any_of(zones.begin(), zones.end(), [x, z](ExclusionZone const& zone) {
+        auto dx = static_cast<long long>(x) - zone.x;
+        auto dz = static_cast<long long>(z) - zone.z;
+        if (zone.isCircle) {
+            return dx * dx + dz * dz <= static_cast<long long>(zone.radius) * zone.radius;
+        }
+        return std::max(std::abs(dx), std::abs(dz)) <= zone.radius;
+    });
+}
+
+std::optional<std::pair<int, int>> AreaSampler::sample(Area const& area, std::vector<ExclusionZone> const& zones) {
+    for (int i = 0; i < MaxAttempts; ++i) {
+        auto [x, z] = sample(area);
+        if (!isExcluded(x, z, zones)) {
+            return std::pair{x, z};
+        }
+    }
+    return std::nullopt;
+}
+
+
+} // namespace ltps::tpr
@@ -0,0 +1,64 @@
+#pragma once
+#include "ltps/Global.h"
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace ltps::tpr {
+
+
+/**
+ * @brief Tpr 随机区域采样
+ * 支持方形、圆形与环形（最小 / 最大半径）区域的均匀采样，并拒绝落在排除区域（如出生点）内的点。
+ * 随机数引擎按线程创建一次，不再每次采样读取 random_device。
+ */
+class AreaSampler {
+public:
+    enum class Shape {
+        Square, // 方形，边长 2 * maxRadius
+        Circle, // 圆形，minRadius > 0 时为环形
+        Range   // x、z 均在 [rangeMin, rangeMax] 内
+    };
+
+    struct Area {
+        Shape shape{Shape::Square};
+        int   centerX{0};
+        int   centerZ{0};
+        int   minRadius{0}; // 距中心的最小距离（方形为切比雪夫距离）
+        int   maxRadius{0};
+        int   rangeMin{0}; // 仅 Range
+        int   rangeMax{0}; // 仅 Range
+    };
+
+    // 排除区域
+    struct ExclusionZone {
+        int  x        = 0;
+        int  z        = 0;
+        int  radius   = 100;
+        bool isCircle = true; // true: 圆形  false: 方形
+    };
+
+    static inline constexpr int MaxAttempts = 32; // 落在排除区域时最多重新采样次数
+
+    // 当前线程的随机数引擎
+    TPSNDAPI static std::mt19937_64& getEngine();
+
+    TPSNDAPI static int randomInt(int min, int max);
+
+    // 在区域内均匀采样一个方块坐标 (x, z)
+    TPSNDAPI static std::pair<int, int> sample(Area const& area);
+
+    // 点是否位于区域内（含环形的内边界）
+    TPSNDAPI static bool contains(Area const& area, int x, int z);
+
+    TPSNDAPI static bool isExcluded(int x, int z, std::vector<ExclusionZone> const& zones);
+
+    // 采样并跳过排除区域，MaxAttempts 次均被排除时返回 nullopt
+    TPSNDAPI static std::optional<std::pair<int, int>>
+    sample(Area const& area, std::vector<ExclusionZone> const& zones);
+};
+
+
+} // namespace ltps::tpr
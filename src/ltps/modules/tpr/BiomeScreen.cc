@@ -0,0 +1,81 @@
+#include "ltps/modules/tpr/BiomeScreen.h"
+#include "ll/api/service/Bedrock.h"
+#include "ltps/base/Config.h"
+#include <mc/deps/core/string/HashedString.h>
+#include <mc/deps/game_refs/WeakRef.h>
+#include <mc/world/level/BlockPos.h>
+#include <mc/world/level/Level.h>
+#include <mc/world/level/biome/Biome.h>
+#include <mc/world/level/biome/source/BiomeSource.h>
+#include <mc/world/level/dimension/Dimension.h>
+#include <mc/world/level/levelgen/WorldGenerator.h>
+
+
+namespace ltps::tpr {
+
+
+BiomeScreen::BiomeScreen() = default;
+
+bool BiomeScreen::isRejectedBiome(
+    std::string_view                       name,
+    bool                                   rejectOceans,
+    bool                                   rejectRivers,
+    std::unordered_set<std::string> const& blacklist
+) {
+    if (name.starts_with("minecraft:")) {
+        name.remove_prefix(10);
+    }
+    // 海洋、深海、暖水海洋... 与河流、冻河
+    if (rejectOceans && name.find("ocean") != std::string_view::npos) {
+        return true;
+    }
+    if (rejectRivers && name.find("river") != std::string_view::npos) {
+        return true;
+    }
+    auto key = std::string{name};
+    return blacklist.contains(key) || blacklist.contains("minecraft:" + key);
+}
+
+bool BiomeScreen::accepts(int dimId, int x, int z) {
+    auto const& cfg = getConfig().modules.tpr.biomeScreen;
+    if (!cfg.enable) {
+        return true;
+    }
+
+    auto level = ll::service::getLevel();
+    if (!level) {
+        mMetrics.unavailable++;
+        return true;
+    }
+    auto dimension = level->getDimension(dimId).lock();
+    if (!dimension || !dimension->getWorldGenerator()) {
+        mMetrics.unavailable++;
+        return true;
+    }
+
+    // 群系源只依据种子与气候噪声计算，不会加载或生成区块
+    auto const* biome = dimension->getWorldGenerator()->getBiomeSource().getBiome(BlockPos{x, SampleY, z});
+    if (!biome) {
+        mMetrics.unavailable++;
+        return true;
+    }
+    mMetrics.checked++;
+
+    auto iter = mVerdicts.find(biome);
+    if (iter == mVerdicts.end()) {
+        auto rejected = isRejectedBiome(biome->mHash->getString(), cfg.rejectOceans, cfg.rejectRivers, cfg.blacklist);
+        iter          = mVerdicts.emplace(biome, rejected).first;
+    }
+    if (iter->second) {
+        mMetrics.rejected++;
+        return false;
+    }
+    return true;
+}
+
+BiomeScreen::Metrics const& BiomeScreen::getMetrics() const { return mMetrics; }
+
+void BiomeScreen::reset() { mVerdicts.clear(); }
+
+
+} // namespace ltps::tpr
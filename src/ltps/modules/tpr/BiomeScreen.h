@@ -0,0 +1,62 @@
+#pragma once
+#include "ltps/Global.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+
+class Biome;
+class Dimension;
+
+namespace ltps::tpr {
+
+
+/**
+ * @brief 群系预筛选
+ * 启动 Tpr 任务前通过世界生成器的群系源查询目标点群系（无需加载或生成区块），
+ * 拒绝海洋、河流与配置的黑名单群系，减少生成区块后才发现没有安全位置的情况。
+ * 同一群系的判定结果按指针缓存，配置重载后清空。
+ */
+class BiomeScreen final {
+public:
+    struct Metrics {
+        std::uint64_t checked{0};     // 已检查的采样点
+        std::uint64_t rejected{0};    // 被拒绝的采样点
+        std::uint64_t unavailable{0}; // 无法查询群系（维度未创建或没有世界生成器）
+    };
+
+private:
+    static inline constexpr int SampleY = 64; // 查询群系的高度（接近海平面）
+
+    std::unordered_map<Biome const*, bool> mVerdicts; // 群系 -> 是否拒绝
+    Metrics                                mMetrics;
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(BiomeScreen);
+
+    TPSAPI explicit BiomeScreen();
+
+    /**
+     * @brief 按配置判断群系名是否应被拒绝
+     * @param name 群系名（可带 minecraft: 前缀）
+     */
+    TPSNDAPI static bool isRejectedBiome(
+        std::string_view                       name,
+        bool                                   rejectOceans,
+        bool                                   rejectRivers,
+        std::unordered_set<std::string> const& blacklist
+    );
+
+    // 目标点是否可用，无法查询群系时视为可用
+    TPSNDAPI bool accepts(int dimId, int x, int z);
+
+    TPSNDAPI Metrics const& getMetrics() const;
+
+    // 配置变更后清空判定缓存
+    TPSAPI void reset();
+};
+
+
+} // namespace ltps::tpr
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace ltps::tpr {
+
+
+/**
+ * @brief 方块运行时 Id 位集
+ * 配置中的方块名在启用 / 重载时解析为运行时 Id，查找时只需一次位测试。
+ */
+class BlockIdSet {
+    std::vector<std::uint64_t> mWords;
+    std::size_t                mSize{0};
+
+public:
+    void insert(std::uint32_t id) {
+        auto const word = id >> 6;
+        if (word >= mWords.size()) {
+            mWords.resize(word + 1, 0);
+        }
+        auto const mask = std::uint64_t{1} << (id & 63);
+        if (!(mWords[word] & mask)) {
+            mWords[word] |= mask;
+            ++mSize;
+        }
+    }
+
+    [[nodiscard]] bool contains(std::uint32_t id) const {
+        auto const word = id >> 6;
+        return word < mWords.size() && (mWords[word] >> (id & 63)) & 1;
+    }
+
+    [[nodiscard]] std::size_t size() const { return mSize; }
+
+    [[nodiscard]] bool empty() const { return mSize == 0; }
+
+    void clear() {
+        mWords.clear();
+        mSize = 0;
+    }
+};
+
+
+} // namespace ltps::tpr
@@ -0,0 +1,112 @@
+#include "ChunkLoadWatcher.h"
+#include "ll/api/chrono/GameChrono.h"
+#include "ltps/TeleportSystem.h"
+#include <ll/api/coro/CoroTask.h>
+#include <mc/world/level/chunk/ChunkSource.h>
+#include <mc/world/level/chunk/ChunkState.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <tuple>
+#include <utility>
+
+
+namespace ltps::tpr {
+
+
+ChunkLoadWatcher::ChunkLoadWatcher(ll::thread::ServerThreadExecutor const& executor) {
+    mInterruptableSleep = std::make_shared<ll::coro::InterruptableSleep>();
+    mAbortFlag          = std::make_shared<std::atomic_bool>(false);
+
+    ll::coro::keepThis([this, sleep = mInterruptableSleep, abortFlag = mAbortFlag]() -> ll::coro::CoroTask<> {
+        while (!abortFlag->load()) {
+            if (mWatches.empty()) {
+                co_await sleep->sleepFor(ll::chrono::ticks{IdleSleepTicks});
+            } else {
+                co_await ll::chrono::ticks(1);
+            }
+            if (abortFlag->load()) break;
+            try {
+                _tick();
+            } catch (...) {
+                TeleportSystem::getInstance().getSelf().getLogger().error(
+                    "An exception occurred while checking watched chunks"
+                );
+            }
+        }
+        co_return;
+    }).launch(executor.getDefault());
+}
+
+ChunkLoadWatcher::~ChunkLoadWatcher() {
+    mAbortFlag->store(true);
+    mInterruptableSleep->interrupt(true);
+    mWatches.clear(); // 不再回调
+}
+
+bool ChunkLoadWatcher::isChunkReady(LevelChunk const& chunk) {
+    return static_cast<int>(chunk.mLoadState->load()) >= static_cast<int>(ChunkState::Loaded)
+        && !chunk.mIsEmptyClientChunk;
+}
+
+bool ChunkLoadWatcher::isChunkReady(ChunkSource& chunkSource, ChunkPos const& pos) {
+    if (!chunkSource.isWithinWorldLimit(pos)) return true;
+    auto chunk = chunkSource.getOrLoadChunk(pos, ::ChunkSource::LoadMode::None, true);
+    return chunk && isChunkReady(*chunk);
+}
+
+void ChunkLoadWatcher::watch(
+    ChunkSource&    chunkSource,
+    ChunkPos const& pos,
+    int             timeoutTicks,
+    Callback        callback,
+    WaitCallback    onWaiting
+) {
+    auto chunk = chunkSource.getOrLoadChunk(pos, ::ChunkSource::LoadMode::Deferred, false);
+
+    bool const wasIdle = mWatches.empty();
+    mWatches.push_back(
+        {&chunkSource, pos, std::move(chunk), timeoutTicks, timeoutTicks, std::move(callback), std::move(onWaiting)}
+    );
+    if (wasIdle) {
+        mInterruptableSleep->interrupt(); // 唤醒空闲协程
+    }
+}
+
+std::size_t ChunkLoadWatcher::size() const { return mWatches.size(); }
+
+void ChunkLoadWatcher::_tick() {
+    std::vector<std::tuple<Callback, bool, std::shared_ptr<LevelChunk>>> fired;
+    std::vector<std::tuple<WaitCallback, int, int>>                      waiting;
+
+    for (std::size_t i = 0; i < mWatches.size();) {
+        auto& watch = mWatches[i];
+        if (!watch.mChunk) {
+            watch.mChunk = watch.mChunkSource->getOrLoadChunk(watch.mPos, ::ChunkSource::LoadMode::None, true);
+        }
+
+        bool const loaded = !watch.mChunkSource->isWithinWorldLimit(watch.mPos)
+                         || (watch.mChunk && isChunkReady(*watch.mChunk));
+        if (loaded || --watch.mTicksLeft <= 0) {
+            fired.emplace_back(std::move(watch.mCallback), loaded, std::move(watch.mChunk));
+            if (i + 1 != mWatches.size()) {
+                watch = std::move(mWatches.back());
+            }
+            mWatches.pop_back();
+            continue;
+        }
+        if (auto waited = watch.mTimeoutTicks - watch.mTicksLeft; watch.mOnWaiting && waited % WaitIntervalTicks == 0) {
+            waiting.emplace_back(watch.mOnWaiting, waited, watch.mTimeoutTicks);
+        }
+        ++i;
+    }
+
+    // 回调中可能再次 watch，统一在遍历结束后调用
+    for (auto& [onWaiting, waited, timeout] : waiting) {
+        onWaiting(waited, timeout);
+    }
+    for (auto& [callback, loaded, chunk] : fired) {
+        callback(loaded, std::move(chunk));
+    }
+}
+
+
+} // namespace ltps::tpr
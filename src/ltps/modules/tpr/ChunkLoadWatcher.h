@@ -0,0 +1,77 @@
+#pragma once
+#include "ltps/Global.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <ll/api/coro/InterruptableSleep.h>
+#include <ll/api/thread/ServerThreadExecutor.h>
+#include <mc/world/level/ChunkPos.h>
+#include <memory>
+#include <vector>
+
+
+class ChunkSource;
+class LevelChunk;
+
+namespace ltps::tpr {
+
+
+/**
+ * @brief 区块加载监听
+ * 以 Deferred 模式请求加载目标区块（不移动玩家），每 tick 检查已登记的区块，
+ * 区块就绪或超时的当 tick 回调；没有登记的区块时协程休眠，直到新的 watch 唤醒。
+ * 附近没有玩家时区块可能一直无法就绪，调用方应在超时后自行回退。
+ * 回调时交出持有的区块，调用方需要在后续读取期间继续持有，避免区块被卸载。
+ */
+class ChunkLoadWatcher final {
+public:
+    // loaded: false 为超时；chunk: 持有的区块（超出世界边界或超时时可能为空）
+    using Callback     = std::function<void(bool loaded, std::shared_ptr<LevelChunk> chunk)>;
+    using WaitCallback = std::function<void(int ticksWaited, int timeoutTicks)>; // 等待期间周期回调
+
+private:
+    struct Watch {
+        ChunkSource*                mChunkSource;
+        ChunkPos                    mPos;
+        std::shared_ptr<LevelChunk> mChunk; // 持有区块，加载期间不被回收
+        int                         mTimeoutTicks;
+        int                         mTicksLeft;
+        Callback                    mCallback;
+        WaitCallback                mOnWaiting;
+    };
+
+    static inline constexpr int IdleSleepTicks    = 1200; // 空闲休眠时长，watch 时提前唤醒
+    static inline constexpr int WaitIntervalTicks = 10;   // 等待回调间隔
+
+    std::vector<Watch>                            mWatches;
+    std::shared_ptr<ll::coro::InterruptableSleep> mInterruptableSleep{nullptr};
+    std::shared_ptr<std::atomic_bool>             mAbortFlag{nullptr};
+
+    void _tick();
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(ChunkLoadWatcher);
+
+    TPSAPI explicit ChunkLoadWatcher(ll::thread::ServerThreadExecutor const& executor);
+    TPSAPI ~ChunkLoadWatcher();
+
+    // 区块已加载到可读取方块
+    TPSNDAPI static bool isChunkReady(LevelChunk const& chunk);
+
+    // 区块是否已就绪（超出世界边界视为就绪）
+    TPSNDAPI static bool isChunkReady(ChunkSource& chunkSource, ChunkPos const& pos);
+
+    // 请求加载区块，就绪或 timeoutTicks 后回调（服务器线程），等待期间每 10 tick 调用 onWaiting
+    TPSAPI void watch(
+        ChunkSource&    chunkSource,
+        ChunkPos const& pos,
+        int             timeoutTicks,
+        Callback        callback,
+        WaitCallback    onWaiting = {}
+    );
+
+    TPSNDAPI std::size_t size() const;
+};
+
+
+} // namespace ltps::tpr
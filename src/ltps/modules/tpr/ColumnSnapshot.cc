@@ -0,0 +1,77 @@
+#include "ltps/modules/tpr/ColumnSnapshot.h"
+#include <algorithm>
+
+
+namespace ltps::tpr {
+
+
+ColumnSnapshot::ColumnSnapshot(
+    int                x,
+    int                z,
+    int                minY,
+    int                maxY,
+    int                bottomY,
+    int                topY,
+    std::optional<int> heightmap,
+    std::uint32_t      airId
+)
+: mX(x),
+  mZ(z),
+  mMinY(minY),
+  mMaxY(maxY),
+  mTopY(std::clamp(topY, minY, maxY)),
+  mBottomY(std::clamp(bottomY, minY, mTopY)),
+  mHeightmap(heightmap),
+  mAirId(airId),
+  mBlocks(static_cast<std::size_t>(mTopY - mBottomY), airId),
+  mEmptySections(static_cast<std::size_t>((maxY - minY + SafePosFinder::SectionHeight - 1) / SafePosFinder::SectionHeight)) {}
+
+void ColumnSnapshot::set(int y, std::uint32_t runtimeId) {
+    if (y >= mBottomY && y < mTopY) {
+        mBlocks[y - mBottomY] = runtimeId;
+    }
+}
+
+std::uint32_t ColumnSnapshot::get(int y) const {
+    if (y < mBottomY || y >= mTopY) {
+        return mAirId;
+    }
+    return mBlocks[y - mBottomY];
+}
+
+void ColumnSnapshot::markSectionEmpty(int sectionIndex) {
+    if (sectionIndex >= 0 && sectionIndex < static_cast<int>(mEmptySections.size())) {
+        mEmptySections[sectionIndex] = true;
+    }
+}
+
+bool ColumnSnapshot::isSectionEmpty(int sectionIndex) const {
+    if (mMinY + (sectionIndex + 1) * SafePosFinder::SectionHeight <= mBottomY) {
+        return true; // 整个子区块在复制范围之下
+    }
+    return sectionIndex >= 0 && sectionIndex < static_cast<int>(mEmptySections.size()) && mEmptySections[sectionIndex];
+}
+
+
+SnapshotAnalysis findInSnapshots(
+    std::vector<ColumnSnapshot> const& snapshots,
+    int                                startY,
+    BlockIdSet const&                  dangerousBlocks,
+    SafePosSearchStats*                stats
+) {
+    SnapshotAnalysis analysis;
+    for (std::size_t i = 0; i < snapshots.size(); ++i) {
+        // 复制范围之下视为空气，不会产生落脚点，因此部分快照的结果只可能漏判、不会误判
+        if (auto y = SafePosFinder::find(ColumnSnapshotView{snapshots[i], dangerousBlocks}, startY, stats)) {
+            analysis.found = SnapshotSearchResult{i, *y};
+            return analysis;
+        }
+        if (snapshots[i].isPartial()) {
+            analysis.incomplete.push_back(i);
+        }
+    }
+    return analysis;
+}
+
+
+} // namespace ltps::tpr
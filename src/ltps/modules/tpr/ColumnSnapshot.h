@@ -0,0 +1,115 @@
+#pragma once
+#include "ltps/Global.h"
+#include "ltps/modules/tpr/BlockIdSet.h"
+#include "ltps/modules/tpr/SafePosFinder.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+namespace ltps::tpr {
+
+
+/**
+ * @brief 单列方块快照
+ * 服务器线程只复制方块运行时 Id、高度图与空子区块标记，安全分析在线程池中进行。
+ * 复制范围为 [bottomY, topY)，范围外与空子区块视为空气；bottomY 高于 minY 时为部分快照，
+ * 范围内没有安全位置时需要复制更深的范围再分析。
+ */
+class ColumnSnapshot {
+    int                        mX;
+    int                        mZ;
+    int                        mMinY;
+    int                        mMaxY;
+    int                        mTopY;
+    int                        mBottomY;
+    std::optional<int>         mHeightmap;
+    std::uint32_t              mAirId;
+    std::vector<std::uint32_t> mBlocks;
+    std::vector<bool>          mEmptySections;
+
+public:
+    TPSAPI ColumnSnapshot(
+        int                x,
+        int                z,
+        int                minY,
+        int                maxY,
+        int                bottomY,
+        int                topY,
+        std::optional<int> heightmap,
+        std::uint32_t      airId
+    );
+
+    [[nodiscard]] int getX() const { return mX; }
+    [[nodiscard]] int getZ() const { return mZ; }
+    [[nodiscard]] int getMinY() const { return mMinY; }
+    [[nodiscard]] int getMaxY() const { return mMaxY; }
+    [[nodiscard]] int getBottomY() const { return mBottomY; }
+    [[nodiscard]] int getTopY() const { return mTopY; }
+
+    [[nodiscard]] bool isPartial() const { return mBottomY > mMinY; }
+
+    [[nodiscard]] std::optional<int> const& getHeightmap() const { return mHeightmap; }
+
+    [[nodiscard]] std::uint32_t getAirId() const { return mAirId; }
+
+    TPSAPI void set(int y, std::uint32_t runtimeId);
+
+    TPSNDAPI std::uint32_t get(int y) const;
+
+    TPSAPI void markSectionEmpty(int sectionIndex);
+
+    TPSNDAPI bool isSectionEmpty(int sectionIndex) const;
+};
+
+
+// 快照的列视图，按危险方块集合分类
+class ColumnSnapshotView final : public IColumnView {
+    ColumnSnapshot const& mSnapshot;
+    BlockIdSet const&     mDangerousBlocks;
+
+public:
+    ColumnSnapshotView(ColumnSnapshot const& snapshot, BlockIdSet const& dangerousBlocks)
+    : mSnapshot(snapshot),
+      mDangerousBlocks(dangerousBlocks) {}
+
+    int getMinY() const override { return mSnapshot.getMinY(); }
+    int getMaxY() const override { return mSnapshot.getMaxY(); }
+
+    std::optional<int> getHeightmap() const override { return mSnapshot.getHeightmap(); }
+
+    bool isSectionEmpty(int sectionIndex) const override { return mSnapshot.isSectionEmpty(sectionIndex); }
+
+    ColumnBlock getBlock(int y) const override {
+        auto id = mSnapshot.get(y);
+        if (id == mSnapshot.getAirId()) {
+            return ColumnBlock::Air;
+        }
+        return mDangerousBlocks.contains(id) ? ColumnBlock::Dangerous : ColumnBlock::Solid;
+    }
+};
+
+
+struct SnapshotSearchResult {
+    std::size_t index; // 快照下标
+    int         y;     // 玩家脚部 Y
+};
+
+struct SnapshotAnalysis {
+    std::optional<SnapshotSearchResult> found;
+    std::vector<std::size_t>            incomplete; // 部分快照内没有安全位置，需要复制更深的范围
+};
+
+/**
+ * @brief 按顺序分析快照，返回第一个有安全位置的列（可在任意线程调用）
+ */
+TPSNDAPI SnapshotAnalysis findInSnapshots(
+    std::vector<ColumnSnapshot> const& snapshots,
+    int                                startY,
+    BlockIdSet const&                  dangerousBlocks,
+    SafePosSearchStats*                stats = nullptr
+);
+
+
+} // namespace ltps::tpr
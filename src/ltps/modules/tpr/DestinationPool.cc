@@ -0,0 +1,202 @@
+#include "DestinationPool.h"
+#include "SafeTeleport.h"
+#include "TprModule.h"
+#include "ll/api/chrono/GameChrono.h"
+#include "ll/api/service/Bedrock.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <ll/api/coro/CoroTask.h>
+#include <mc/deps/game_refs/WeakRef.h>
+#include <mc/world/level/BlockPos.h>
+#include <mc/world/level/ChunkPos.h>
+#include <mc/world/level/Level.h>
+#include <mc/world/level/chunk/ChunkSource.h>
+#include <mc/world/level/dimension/Dimension.h>
+
+
+namespace ltps::tpr {
+
+
+namespace {
+
+constexpr std::array<int, 3> Dimensions = {0, 1, 2}; // 主世界、下界、末地
+
+} // namespace
+
+
+DestinationPool::DestinationPool(SafeTeleport& safeTeleport, ll::thread::ServerThreadExecutor const& executor)
+: mSafeTeleport(safeTeleport) {
+    mInterruptableSleep = std::make_shared<ll::coro::InterruptableSleep>();
+    mAbortFlag          = std::make_shared<std::atomic_bool>(false);
+
+    ll::coro::keepThis([this, sleep = mInterruptableSleep, abortFlag = mAbortFlag]() -> ll::coro::CoroTask<> {
+        while (!abortFlag->load()) {
+            auto interval = std::max(getConfig().modules.tpr.pool.refillIntervalTicks, 1);
+            co_await sleep->sleepFor(ll::chrono::ticks{interval});
+            if (abortFlag->load()) break;
+            try {
+                _refill();
+            } catch (...) {
+                TeleportSystem::getInstance().getSelf().getLogger().error(
+                    "An exception occurred while refilling the TPR destination pool"
+                );
+            }
+        }
+        co_return;
+    }).launch(executor.getDefault());
+}
+
+DestinationPool::~DestinationPool() {
+    mAbortFlag->store(true);
+    mInterruptableSleep->interrupt(true);
+}
+
+bool DestinationPool::isUsable() {
+    auto const& cfg = getConfig().modules.tpr;
+    return cfg.pool.enable && cfg.pool.size > 0
+        && (!cfg.restrictedAreas.enable || !cfg.restrictedAreas.center.usePlayerPositionCenter);
+}
+
+std::optional<Vec3> DestinationPool::take(int dimId) {
+    if (!isUsable()) {
+        return std::nullopt;
+    }
+    _expire();
+
+    auto iter = mPools.find(dimId);
+    if (iter == mPools.end() || iter->second.empty()) {
+        return std::nullopt;
+    }
+    auto pos = iter->second.front().mPos;
+    iter->second.pop_front();
+    return pos;
+}
+
+void DestinationPool::giveBack(int dimId, Vec3 const& pos) {
+    mPools[dimId].push_front({pos, Clock::now()}); // 放回队首，下次优先使用
+}
+
+std::size_t DestinationPool::size(int dimId) const {
+    auto iter = mPools.find(dimId);
+    return iter == mPools.end() ? 0 : iter->second.size();
+}
+
+void DestinationPool::clear() {
+    mPools.clear();
+    mBackoffs.clear();
+}
+
+void DestinationPool::_expire() {
+    auto const ttl = std::chrono::seconds{getConfig().modules.tpr.pool.ttlSeconds};
+    auto const now = Clock::now();
+    for (auto& [_, pool] : mPools) {
+        std::erase_if(pool, [&](Destination const& dest) { return now - dest.mCreatedAt > ttl; });
+    }
+}
+
+void DestinationPool::_refill() {
+    if (!isUsable()) {
+        return;
+    }
+    _expire();
+
+    if (mProbing || mSafeTeleport.hasActiveTasks()) {
+        return; // 只在空闲时补充，避免与玩家的区块加载竞争
+    }
+    _startProbe();
+}
+
+void DestinationPool::_startProbe() {
+    auto level = ll::service::getLevel();
+    if (!level) {
+        return;
+    }
+
+    auto const& cfg = getConfig().modules.tpr;
+    auto const  now = Clock::now();
+    for (std::size_t i = 0; i < Dimensions.size(); ++i) {
+        auto dimId = Dimensions[mNextDim++ % Dimensions.size()];
+        if (cfg.disallowedDimensions.contains(dimId) || size(dimId) >= static_cast<std::size_t>(cfg.pool.size)) {
+            continue;
+        }
+        if (auto iter = mBackoffs.find(dimId); iter != mBackoffs.end() && now < iter->second.mUntil) {
+            continue; // 最近加载失败，暂停补充
+        }
+
+        auto dimension = level->getDimension(dimId).lock();
+        if (!dimension) {
+            continue; // 维度尚未创建
+        }
+
+        auto random = TprModule::getRandomPosWithConfig(Vec3{}, dimId, mSafeTeleport);
+        if (!random) {
+            continue;
+        }
+        auto  origin      = *random;
+        auto  chunkPos    = ChunkPos{BlockPos{origin}};
+        auto& chunkSource = dimension->getChunkSource();
+        if (!chunkSource.isWithinWorldLimit(chunkPos) || !mSafeTeleport.tryAcquireChunkLoad(dimId)) {
+            continue; // 玩家的任务占满加载名额时不加载
+        }
+
+        mProbing = true;
+        mSafeTeleport.getChunkLoadWatcher().watch(
+            chunkSource,
+            chunkPos,
+            ProbeTimeoutTicks,
+            [this, dimId, origin, &safeTeleport = mSafeTeleport, abortFlag = mAbortFlag](
+                bool                        loaded,
+                std::shared_ptr<LevelChunk> chunk
+            ) {
+                safeTeleport.releaseChunkLoad(dimId); // 监听回调期间 SafeTeleport 一定存在
+                if (abortFlag->load()) return;        // 已析构
+                if (!loaded) {
+                    _onProbeFailed(dimId);
+                    return;
+                }
+                _onProbeLoaded(dimId, origin, std::move(chunk));
+            }
+        );
+        return;
+    }
+}
+
+void DestinationPool::_onProbeLoaded(int dimId, Vec3 const& origin, std::shared_ptr<LevelChunk> chunk) {
+    // 与玩家的查找共享每 tick 读取预算，查找结束前持有探测区块
+    mSafeTeleport.getSearchScheduler().submit(
+        dimId,
+        origin,
+        [this, dimId, origin, abortFlag = mAbortFlag](std::optional<Vec3> result, bool chunkLost) {
+            if (abortFlag->load()) return;
+            if (chunkLost) {
+                _onProbeFailed(dimId); // 区块被卸载，不记录拒绝区域
+                return;
+            }
+            mProbing = false;
+            mBackoffs.erase(dimId);
+            if (result) {
+                mPools[dimId].push_back({*result, Clock::now()});
+            } else if (getConfig().modules.tpr.rejectedRegions.enable) {
+                auto const x = static_cast<int>(std::floor(origin.x));
+                auto const z = static_cast<int>(std::floor(origin.z));
+                mSafeTeleport.getRejectedRegions().reject(dimId, x, z);
+            }
+        },
+        std::move(chunk)
+    );
+}
+
+void DestinationPool::_onProbeFailed(int dimId) {
+    mProbing = false;
+
+    // 附近没有玩家时区块可能一直无法加载，暂停该维度的补充，避免反复加载
+    auto& backoff  = mBackoffs[dimId];
+    backoff.mUntil = Clock::now() + BackoffBase * (1 << std::min(backoff.mFailures, MaxBackoffShift));
+    backoff.mFailures++;
+}
+
+
+} // namespace ltps::tpr
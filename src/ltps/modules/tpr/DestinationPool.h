@@ -0,0 +1,85 @@
+#pragma once
+#include "ltps/Global.h"
+#include "mc/deps/core/math/Vec3.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <ll/api/coro/InterruptableSleep.h>
+#include <ll/api/thread/ServerThreadExecutor.h>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+
+class LevelChunk;
+
+namespace ltps::tpr {
+
+
+class SafeTeleport;
+
+/**
+ * @brief 预选 Tpr 目的地池
+ * 服务器空闲时（无进行中的 Tpr 任务）在后台逐个加载随机区块并查找安全位置，
+ * 按维度缓存已验证的目的地，玩家请求时优先从池中取出，池为空时再走区块加载流程。
+ * 候选区块占用 SafeTeleport 的区块加载名额（tpr.maxConcurrentChunkLoads），有任务排队时不加载；
+ * 加载超时的维度暂停补充，连续失败时暂停时长翻倍。
+ * 仅在随机范围不依赖玩家位置时启用，配置重载后清空。
+ */
+class DestinationPool final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Destination {
+        Vec3              mPos;
+        Clock::time_point mCreatedAt;
+    };
+
+private:
+    // 候选区块加载失败后的暂停
+    struct Backoff {
+        int               mFailures{0}; // 连续失败次数
+        Clock::time_point mUntil;
+    };
+
+    static inline constexpr int  ProbeTimeoutTicks = 640;                      // 候选区块加载超时（tick）
+    static inline constexpr auto BackoffBase       = std::chrono::seconds{30}; // 首次失败的暂停时长
+    static inline constexpr int  MaxBackoffShift   = 5;                        // 暂停时长最多翻倍次数
+
+    SafeTeleport&                                    mSafeTeleport;
+    std::unordered_map<int, std::deque<Destination>> mPools;          // 维度 -> 目的地
+    std::unordered_map<int, Backoff>                 mBackoffs;       // 维度 -> 加载失败暂停
+    bool                                             mProbing{false}; // 同一时间只加载一个候选区块
+    std::size_t                                      mNextDim{0};     // 轮流补充各维度
+    std::shared_ptr<ll::coro::InterruptableSleep>    mInterruptableSleep{nullptr};
+    std::shared_ptr<std::atomic_bool>                mAbortFlag{nullptr};
+
+    void _refill();
+    void _expire();
+    void _startProbe();
+    void _onProbeLoaded(int dimId, Vec3 const& origin, std::shared_ptr<LevelChunk> chunk);
+    void _onProbeFailed(int dimId);
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(DestinationPool);
+
+    TPSAPI explicit DestinationPool(SafeTeleport& safeTeleport, ll::thread::ServerThreadExecutor const& executor);
+    TPSAPI ~DestinationPool();
+
+    // 当前配置是否可使用预选目的地
+    TPSNDAPI static bool isUsable();
+
+    // 取出一个未过期的目的地
+    TPSNDAPI std::optional<Vec3> take(int dimId);
+
+    // 归还未使用的目的地（请求被取消）
+    TPSAPI void giveBack(int dimId, Vec3 const& pos);
+
+    TPSNDAPI std::size_t size(int dimId) const;
+
+    TPSAPI void clear();
+};
+
+
+} // namespace ltps::tpr
@@ -0,0 +1,115 @@
+#include "ltps/modules/tpr/NeighborhoodCoalescer.h"
+#include <algorithm>
+
+
+namespace ltps::tpr {
+
+
+namespace {
+
+long long distance2(std::pair<int, int> const& a, int x, int z) {
+    auto dx = static_cast<long long>(a.first) - x;
+    auto dz = static_cast<long long>(a.second) - z;
+    return dx * dx + dz * dz;
+}
+
+} // namespace
+
+
+NeighborhoodCoalescer::NeighborhoodCoalescer() = default;
+
+void NeighborhoodCoalescer::configure(Options const& options) {
+    mOptions = options;
+    clear();
+}
+
+void NeighborhoodCoalescer::_expire(Clock::time_point now) {
+    std::erase_if(mNeighborhoods, [&](Neighborhood const& hood) { return now - hood.mCreatedAt > mOptions.window; });
+}
+
+void NeighborhoodCoalescer::record(int dimId, int x, int z, Clock::time_point now) {
+    if (mOptions.maxNeighborhoods == 0) {
+        return;
+    }
+    _expire(now);
+
+    auto const radius2 = static_cast<long long>(mOptions.radius) * mOptions.radius;
+    for (auto const& hood : mNeighborhoods) {
+        if (hood.mDimId == dimId && distance2({hood.mCenterX, hood.mCenterZ}, x, z) <= radius2) {
+            return;
+        }
+    }
+
+    if (mNeighborhoods.size() >= mOptions.maxNeighborhoods) {
+        mNeighborhoods.erase(mNeighborhoods.begin());
+    }
+    mNeighborhoods.push_back({dimId, x, z, now, {{x, z}}});
+}
+
+void NeighborhoodCoalescer::forget(int dimId, int x, int z) {
+    auto const radius2 = static_cast<long long>(mOptions.radius) * mOptions.radius;
+    std::erase_if(mNeighborhoods, [&](Neighborhood const& hood) {
+        return hood.mDimId == dimId && distance2({hood.mCenterX, hood.mCenterZ}, x, z) <= radius2;
+    });
+}
+
+void NeighborhoodCoalescer::release(int dimId, int x, int z) {
+    for (auto iter = mNeighborhoods.begin(); iter != mNeighborhoods.end(); ++iter) {
+        if (iter->mDimId != dimId) {
+            continue;
+        }
+        auto& assigned = iter->mAssigned;
+        if (auto found = std::find(assigned.begin(), assigned.end(), std::pair{x, z}); found != assigned.end()) {
+            assigned.erase(found);
+            if (assigned.empty()) {
+                mNeighborhoods.erase(iter);
+            }
+            return;
+        }
+    }
+}
+
+std::optional<std::pair<int, int>> NeighborhoodCoalescer::pick(
+    int                                             dimId,
+    AreaSampler::Area const&                        area,
+    std::vector<AreaSampler::ExclusionZone> const& exclusions,
+    Filter const&                                   accepts,
+    Clock::time_point                               now
+) {
+    _expire(now);
+
+    auto const minDistance2 = static_cast<long long>(mOptions.minDistance) * mOptions.minDistance;
+
+    // 优先分配最新的邻域（区块最可能仍在内存中）
+    for (auto iter = mNeighborhoods.rbegin(); iter != mNeighborhoods.rend(); ++iter) {
+        auto& hood = *iter;
+        if (hood.mDimId != dimId || hood.mAssigned.size() >= mOptions.maxPerNeighborhood) {
+            continue;
+        }
+
+        auto const around =
+            AreaSampler::Area{AreaSampler::Shape::Circle, hood.mCenterX, hood.mCenterZ, 0, mOptions.radius};
+        for (int i = 0; i < SampleAttempts; ++i) {
+            auto [x, z] = AreaSampler::sample(around);
+            if (!AreaSampler::contains(area, x, z) || AreaSampler::isExcluded(x, z, exclusions)) {
+                continue;
+            }
+            bool tooClose = std::any_of(hood.mAssigned.begin(), hood.mAssigned.end(), [&](auto const& assigned) {
+                return distance2(assigned, x, z) < minDistance2;
+            });
+            if (tooClose || (accepts && !accepts(x, z))) {
+                continue;
+            }
+            hood.mAssigned.emplace_back(x, z);
+            return std::pair{x, z};
+        }
+    }
+    return std::nullopt;
+}
+
+std::size_t NeighborhoodCoalescer::size() const { return mNeighborhoods.size(); }
+
+void NeighborhoodCoalescer::clear() { mNeighborhoods.clear(); }
+
+
+} // namespace ltps::tpr
@@ -0,0 +1,90 @@
+#pragma once
+#include "ltps/Global.h"
+#include "ltps/modules/tpr/AreaSampler.h"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+namespace ltps::tpr {
+
+
+/**
+ * @brief Tpr 区块邻域合并
+ * 记录最近随机选中（区块正在或已经加载）的邻域，同一时间段内的其它 Tpr 请求优先分配到这些邻域内，
+ * 分配点之间至少相隔 minDistance，每个邻域最多分配 maxPerNeighborhood 次，
+ * 使大量玩家同时随机传送时只需生成少量区块。
+ */
+class NeighborhoodCoalescer final {
+public:
+    using Clock  = std::chrono::steady_clock;
+    using Filter = std::function<bool(int x, int z)>; // 返回 false 时不分配该点
+
+    struct Options {
+        int             radius{32};            // 邻域半径（方块）
+        int             minDistance{24};       // 分配点之间的最小距离
+        std::size_t     maxPerNeighborhood{4}; // 每个邻域最多分配次数（含首次加载）
+        std::size_t     maxNeighborhoods{16};  // 最多记录的邻域数
+        Clock::duration window{std::chrono::seconds{30}};
+    };
+
+private:
+    static inline constexpr int SampleAttempts = 8; // 每个邻域内的采样次数
+
+    struct Neighborhood {
+        int                              mDimId;
+        int                              mCenterX;
+        int                              mCenterZ;
+        Clock::time_point                mCreatedAt;
+        std::vector<std::pair<int, int>> mAssigned; // 已分配的点
+    };
+
+    Options                   mOptions;
+    std::vector<Neighborhood> mNeighborhoods; // 按创建时间排序
+
+    void _expire(Clock::time_point now);
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(NeighborhoodCoalescer);
+
+    TPSAPI explicit NeighborhoodCoalescer();
+
+    // 修改参数，清空已有邻域
+    TPSAPI void configure(Options const& options);
+
+    /**
+     * @brief 记录新加载的位置
+     * 位于已有邻域内时忽略（分配时已计数），否则创建新邻域，超出数量时淘汰最早的邻域。
+     */
+    TPSAPI void record(int dimId, int x, int z, Clock::time_point now = Clock::now());
+
+    // 移除包含该点的邻域（邻域内没有安全位置）
+    TPSAPI void forget(int dimId, int x, int z);
+
+    // 归还 pick 分配的点（请求被取消），邻域内没有分配点时移除邻域
+    TPSAPI void release(int dimId, int x, int z);
+
+    /**
+     * @brief 在最近的邻域内为新请求分配坐标
+     * @param area 请求的随机区域，分配点必须位于区域内且不在排除区域内
+     * @param accepts 额外的筛选（如已拒绝区域、群系预筛选），为空时不筛选
+     * @return 没有可用邻域时返回 nullopt，调用方改为随机选点
+     */
+    TPSNDAPI std::optional<std::pair<int, int>> pick(
+        int                                             dimId,
+        AreaSampler::Area const&                        area,
+        std::vector<AreaSampler::ExclusionZone> const& exclusions,
+        Filter const&                                   accepts = {},
+        Clock::time_point                               now     = Clock::now()
+    );
+
+    TPSNDAPI std::size_t size() const;
+
+    TPSAPI void clear();
+};
+
+
+} // namespace ltps::tpr
@@ -0,0 +1,84 @@
+#include "ltps/modules/tpr/RejectedRegionCache.h"
+#include <algorithm>
+
+
+namespace ltps::tpr {
+
+
+namespace {
+
+// 向下取整的网格坐标
+int toCell(int v, int cellSize) { return v >= 0 ? v / cellSize : (v - cellSize + 1) / cellSize; }
+
+} // namespace
+
+
+RejectedRegionCache::RejectedRegionCache(int cellSize, std::size_t capacity, Clock::duration ttl)
+: mCellSize(std::max(cellSize, 1)),
+  mCapacity(capacity),
+  mTtl(ttl) {}
+
+void RejectedRegionCache::configure(int cellSize, std::size_t capacity, Clock::duration ttl) {
+    cellSize = std::max(cellSize, 1);
+    if (cellSize != mCellSize || ttl != mTtl) {
+        clear(); // 网格变化后记录的键失效，有效期变化后记录的过期时间失效
+    }
+    mCellSize = cellSize;
+    mCapacity = capacity;
+    mTtl      = ttl;
+
+    while (mEntries.size() > mCapacity) {
+        mEntries.erase(mOrder.front());
+        mOrder.pop_front();
+    }
+}
+
+RejectedRegionCache::Key RejectedRegionCache::toKey(int dimId, int x, int z) const {
+    auto cellX = static_cast<std::uint32_t>(toCell(x, mCellSize)) & 0xFFFFFFF;
+    auto cellZ = static_cast<std::uint32_t>(toCell(z, mCellSize)) & 0xFFFFFFF;
+    return static_cast<Key>(static_cast<std::uint8_t>(dimId)) << 56 | static_cast<Key>(cellX) << 28 | cellZ;
+}
+
+void RejectedRegionCache::reject(int dimId, int x, int z, Clock::time_point now) {
+    if (mCapacity == 0) {
+        return;
+    }
+
+    auto key  = toKey(dimId, x, z);
+    auto iter = mEntries.find(key);
+    if (iter != mEntries.end()) {
+        iter->second.mExpiresAt = now + mTtl;
+        mOrder.splice(mOrder.end(), mOrder, iter->second.mOrder);
+        return;
+    }
+
+    while (mEntries.size() >= mCapacity) {
+        mEntries.erase(mOrder.front());
+        mOrder.pop_front();
+    }
+    mOrder.push_back(key);
+    mEntries.emplace(key, Entry{now + mTtl, std::prev(mOrder.end())});
+}
+
+bool RejectedRegionCache::isRejected(int dimId, int x, int z, Clock::time_point now) {
+    auto iter = mEntries.find(toKey(dimId, x, z));
+    if (iter == mEntries.end()) {
+        return false;
+    }
+    if (now >= iter->second.mExpiresAt) {
+        mOrder.erase(iter->second.mOrder); // 已过期，允许再次尝试
+        mEntries.erase(iter);
+        return false;
+    }
+    return true;
+}
+
+std::size_t RejectedRegionCache::size() const { return mEntries.size(); }
+
+void RejectedRegionCache::clear() {
+    mEntries.clear();
+    mOrder.clear();
+}
+
+
+} // namespace ltps::tpr
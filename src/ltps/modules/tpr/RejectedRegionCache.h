@@ -0,0 +1,62 @@
+#pragma once
+#include "ltps/Global.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+
+namespace ltps::tpr {
+
+
+/**
+ * @brief 已拒绝区域缓存
+ * 按维度以 cellSize 为边长的粗网格记录未找到安全位置的区域（海洋、岩浆湖等），
+ * 随机选点时跳过这些区域，避免反复加载区块后才失败。
+ * 记录在 ttl 后过期，地形重新生成或被修改后会再次尝试；超出容量时淘汰最久未被拒绝的记录。
+ */
+class RejectedRegionCache final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    using Key = std::uint64_t;
+
+    struct Entry {
+        Clock::time_point        mExpiresAt;
+        std::list<Key>::iterator mOrder;
+    };
+
+    int                            mCellSize;
+    std::size_t                    mCapacity;
+    Clock::duration                mTtl;
+    std::unordered_map<Key, Entry> mEntries;
+    std::list<Key>                 mOrder; // 最近拒绝的在尾部
+
+    [[nodiscard]] Key toKey(int dimId, int x, int z) const;
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(RejectedRegionCache);
+
+    TPSAPI explicit RejectedRegionCache(
+        int             cellSize = 32,
+        std::size_t     capacity = 4096,
+        Clock::duration ttl      = std::chrono::minutes{30}
+    );
+
+    // 修改网格、容量与有效期；网格或有效期变化时清空已有记录，容量缩小时淘汰最久未被拒绝的记录
+    TPSAPI void configure(int cellSize, std::size_t capacity, Clock::duration ttl);
+
+    // 记录 (x, z) 所在网格不可用，重复拒绝时刷新有效期
+    TPSAPI void reject(int dimId, int x, int z, Clock::time_point now = Clock::now());
+
+    TPSNDAPI bool isRejected(int dimId, int x, int z, Clock::time_point now = Clock::now());
+
+    TPSNDAPI std::size_t size() const;
+
+    TPSAPI void clear();
+};
+
+
+} // namespace ltps::tpr
@@ -0,0 +1,113 @@
+#include "ltps/modules/tpr/SafePosFinder.h"
+#include <limits>
+
+
+namespace ltps::tpr {
+
+
+namespace {
+
+ColumnBlock readBlock(IColumnView const& column, int y, SafePosSearchStats* stats) {
+    if (stats) {
+        stats->blockReads++;
+    }
+    return column.getBlock(y);
+}
+
+// 落脚方块可站立，且腿部、头部为空气
+bool isStandable(ColumnBlock block, ColumnBlock leg, ColumnBlock head) {
+    return block == ColumnBlock::Solid && leg == ColumnBlock::Air && head == ColumnBlock::Air;
+}
+
+} // namespace
+
+
+std::optional<int> SafePosFinder::findLinear(IColumnView const& column, int startY, SafePosSearchStats* stats) {
+    auto const end = column.getMinY();
+
+    std::optional<ColumnBlock> headBlock; // 头部方块
+    std::optional<ColumnBlock> legBlock;  // 腿部方块
+
+    for (int y = startY; y > end; --y) {
+        auto block = readBlock(column, y, stats);
+
+        if (!headBlock) { // 第一次循环, 初始化
+            headBlock = block;
+            legBlock  = block;
+        }
+
+        if (isStandable(block, *legBlock, *headBlock)) {
+            return y + 1; // 往上一格，当前格为落脚点方块
+        }
+
+        headBlock = legBlock;
+        legBlock  = block;
+    }
+    return std::nullopt;
+}
+
+std::optional<int> SafePosFinder::find(IColumnView const& column, int startY, SafePosSearchStats* stats) {
+    auto const minY = column.getMinY();
+    auto const maxY = column.getMaxY();
+
+    std::optional<ColumnBlock> headBlock;
+    std::optional<ColumnBlock> legBlock;
+
+    int y = startY;
+
+    // 高度图以上全部为空气，直接从最高的非空气方块开始
+    if (auto heightmap = column.getHeightmap(); heightmap && *heightmap <= startY) {
+        y         = *heightmap - 1;
+        headBlock = ColumnBlock::Air;
+        legBlock  = ColumnBlock::Air;
+    }
+
+    int checkedSection = std::numeric_limits<int>::max();
+    while (y > minY) {
+        // 进入新的子区块时检查是否全为空气，全空气子区块内不可能存在落脚点
+        if (auto section = (y - minY) / SectionHeight; y < maxY && section != checkedSection) {
+            checkedSection = section;
+            if (stats) {
+                stats->sectionChecks++;
+            }
+            if (column.isSectionEmpty(section)) {
+                headBlock = ColumnBlock::Air;
+                legBlock  = ColumnBlock::Air;
+                y         = minY + section * SectionHeight - 1;
+                continue;
+            }
+        }
+
+        auto block = readBlock(column, y, stats);
+
+        if (!headBlock) {
+            headBlock = block;
+            legBlock  = block;
+        }
+
+        if (isStandable(block, *legBlock, *headBlock)) {
+            return y + 1;
+        }
+
+        headBlock = legBlock;
+        legBlock  = block;
+        --y;
+    }
+    return std::nullopt;
+}
+
+std::vector<std::pair<int, int>> const& SafePosFinder::getSpiralOffsets() {
+    static auto const offsets = [] {
+        std::vector<std::pair<int, int>> result;
+        result.reserve(spiralCount(ChunkWidth));
+        forEachSpiralOffset(ChunkWidth, [&](int dx, int dz) {
+            result.emplace_back(dx, dz);
+            return false;
+        });
+        return result;
+    }();
+    return offsets;
+}
+
+
+} // namespace ltps::tpr
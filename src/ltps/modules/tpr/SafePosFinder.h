@@ -0,0 +1,99 @@
+#pragma once
+#include "ltps/Global.h"
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+namespace ltps::tpr {
+
+
+enum class ColumnBlock : uint8_t {
+    Air,      // 空气
+    Solid,    // 可落脚方块
+    Dangerous // 危险方块
+};
+
+
+/**
+ * @brief 单列方块视图
+ * 安全位置查找只依赖此接口，游戏内由 BlockSource 适配，测试中使用合成数据。
+ */
+class IColumnView {
+public:
+    virtual ~IColumnView() = default;
+
+    [[nodiscard]] virtual int getMinY() const = 0; // 最低方块 Y
+    [[nodiscard]] virtual int getMaxY() const = 0; // 最高方块 Y + 1
+
+    // 高度图：最高非空气方块之上的第一格，未知时返回 nullopt
+    [[nodiscard]] virtual std::optional<int> getHeightmap() const = 0;
+
+    // 子区块是否全为空气，sectionIndex = (y - getMinY()) / 16
+    [[nodiscard]] virtual bool isSectionEmpty(int sectionIndex) const = 0;
+
+    [[nodiscard]] virtual ColumnBlock getBlock(int y) const = 0;
+};
+
+
+struct SafePosSearchStats {
+    int blockReads{0};    // 读取方块次数
+    int sectionChecks{0}; // 子区块空检查次数
+};
+
+
+class SafePosFinder {
+public:
+    static inline constexpr int SectionHeight = 16;
+    static inline constexpr int ChunkWidth    = 16;
+
+    /**
+     * @brief 线性扫描（逐格向下读取方块）
+     * @param startY 开始扫描的 Y
+     * @return 玩家脚部 Y（落脚方块之上一格）
+     */
+    TPSNDAPI static std::optional<int>
+    findLinear(IColumnView const& column, int startY, SafePosSearchStats* stats = nullptr);
+
+    /**
+     * @brief 基于高度图与空子区块跳过的扫描
+     * 高度图以上的格子与全空气子区块不读取方块，结果与 findLinear 一致。
+     */
+    TPSNDAPI static std::optional<int> find(IColumnView const& column, int startY, SafePosSearchStats* stats = nullptr);
+
+    // 半径 ChunkWidth 内的螺旋偏移表（forEachSpiralOffset 顺序），用于可中断的逐列查找
+    TPSNDAPI static std::vector<std::pair<int, int>> const& getSpiralOffsets();
+
+    // 半径 r 内的螺旋偏移数量
+    [[nodiscard]] static constexpr int spiralCount(int r) { return (2 * r + 1) * (2 * r + 1); }
+
+    /**
+     * @brief 由内向外按方形螺旋遍历列偏移，(0, 0) 最先
+     * @param maxRadius 最大环半径（切比雪夫距离）
+     * @param fn bool(int dx, int dz)，返回 true 时停止遍历
+     */
+    template <typename Fn>
+    static void forEachSpiralOffset(int maxRadius, Fn&& fn) {
+        if (fn(0, 0)) {
+            return;
+        }
+        for (int r = 1; r <= maxRadius; ++r) {
+            for (int i = -r + 1; i <= r; ++i) { // 右边
+                if (fn(r, i)) return;
+            }
+            for (int i = r - 1; i >= -r; --i) { // 上边
+                if (fn(i, r)) return;
+            }
+            for (int i = r - 1; i >= -r; --i) { // 左边
+                if (fn(-r, i)) return;
+            }
+            for (int i = -r + 1; i <= r; ++i) { // 下边
+                if (fn(i, -r)) return;
+            }
+        }
+    }
+};
+
+
+} // namespace ltps::tpr
@@ -1,24 +1,23 @@
 #include "SafeTeleport.h"
-#include "ll/api/chrono/GameChrono.h"
-#include "ll/api/thread/ServerThreadExecutor.h"
 #include "ltps/Global.h"
 #include "ltps/TeleportSystem.h"
 #include "ltps/base/Config.h"
+#include "ltps/common/TeleportDispatcher.h"
 #include "ltps/utils/McUtils.h"
 #include "mc/deps/ecs/WeakEntityRef.h"
 #include "mc/network/packet/SetTitlePacket.h"
 #include "mc/world/actor/player/Player.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
-#include <ll/api/coro/CoroTask.h>
-#include <ll/api/thread/ThreadPoolExecutor.h>
+#include <optional>
+#include <string>
+#include <unordered_set>
 #include <mc/deps/core/math/Vec3.h>
 #include <mc/deps/game_refs/WeakRef.h>
-#include <mc/world/level/BlockSource.h>
 #include <mc/world/level/block/Block.h>
+#include <mc/world/level/block/BlockLegacy.h>
 #include <mc/world/level/chunk/ChunkSource.h>
-#include <mc/world/level/chunk/ChunkState.h>
-#include <mc/world/level/chunk/LevelChunk.h>
-#include <mc/world/level/dimension/Dimension.h>
 
 namespace ltps::tpr {
 
@@ -26,14 +25,21 @@ namespace ltps::tpr {
 bool SafeTeleport::Task::operator==(const Task& other) const { return mId == other.mId; }
 
 inline SafeTeleport::TaskId NextTaskId = 0;
-SafeTeleport::Task::Task(Player& player, DimensionPos targetPos)
+SafeTeleport::Task::Task(
+    Player&                              player,
+    DimensionPos                         targetPos,
+    long long                            charge,
+    std::optional<CooldownTable::Column> cooldown
+)
 : mId(NextTaskId++),
   mWeakPlayer(player.getWeakEntity()),
   mChunkSource(player.getDimensionBlockSource().getChunkSource()),
   mTargetChunkPos(ChunkPos(targetPos.first)),
   mCachedLocaleCode(player.getLocaleCode()),
   mSourcePos({player.getPosition(), player.getDimensionId()}),
-  mTargetPos(targetPos) {
+  mTargetPos(targetPos),
+  mCharge(charge),
+  mCooldown(cooldown) {
     mTargetPos.first.x += 0.5; // 方块中心
     mTargetPos.first.z += 0.5;
     mTargetPos.first.y  = 3389;
@@ -41,6 +47,7 @@ SafeTeleport::Task::Task(Player& player, DimensionPos targetPos)
 
 
 bool SafeTeleport::Task::isPending() const { return mState == TaskState::Pending; }
+bool SafeTeleport::Task::isQueued() const { return mState == TaskState::Queued; }
 bool SafeTeleport::Task::isWaitingChunkLoad() const { return mState == TaskState::WaitingChunkLoad; }
 bool SafeTeleport::Task::isChunkLoadTimeout() const { return mState == TaskState::ChunkLoadTimeout; }
 bool SafeTeleport::Task::isChunkLoaded() const { return mState == TaskState::ChunkLoaded; }
@@ -57,12 +64,11 @@ Player* SafeTeleport::Task::getPlayer() const { return mWeakPlayer.tryUnwrap<Pla
 
 void SafeTeleport::Task::updateState(TaskState state) { mState = state; }
 
-void SafeTeleport::Task::updateCounter() { mCounter++; }
-
-void SafeTeleport::Task::sendWaitChunkLoadTip() {
+void SafeTeleport::Task::sendWaitChunkLoadTip(int ticksWaited, int timeoutTicks) const {
     if (auto player = getPlayer()) {
-        mTipPacket.mTitleText = "等待区块加载... ({}/{})"_trl(mCachedLocaleCode, mCounter, MaxCounter);
-        mTipPacket.sendTo(*player);
+        SetTitlePacket tip{SetTitlePacket::TitleType::Actionbar};
+        tip.mTitleText = "等待区块加载... ({}/{})"_trl(mCachedLocaleCode, ticksWaited / 20, timeoutTicks / 20);
+        tip.sendTo(*player);
     }
 }
 
@@ -72,234 +78,350 @@ void SafeTeleport::Task::abort() {
 }
 
 void SafeTeleport::Task::rollback() const {
-    if (auto player = getPlayer()) {
+    if (auto player = getPlayer(); player && mLeftSource) {
         player->teleport(mSourcePos.first, mSourcePos.second);
     }
 }
 
 void SafeTeleport::Task::commit() const {
     if (auto player = getPlayer()) {
-        player->teleport(mTargetPos.first, mTargetPos.second);
+        TeleportSystem::getInstance().getTeleportDispatcher().dispatch(
+            *player,
+            mTargetPos.second,
+            [target = mTargetPos](Player& self) { self.teleport(target.first, target.second); },
+            [weak       = mWeakPlayer,
+             source     = mSourcePos,
+             leftSource = mLeftSource,
+             refund     = TeleportDispatcher::makeRefund(*player, mCharge, mCooldown)]() {
+                if (auto player = weak.tryUnwrap<Player>().as_ptr(); player && leftSource) {
+                    player->teleport(source.first, source.second); // 传送被丢弃，返回原位置
+                }
+                refund();
+            }
+        );
     }
 }
 
-bool SafeTeleport::Task::isTargetChunkFullyLoaded() const {
-    if (!mChunkSource.isWithinWorldLimit(mTargetChunkPos)) return true;
-    auto chunk = mChunkSource.getOrLoadChunk(mTargetChunkPos, ::ChunkSource::LoadMode::None, true);
-    return chunk && static_cast<int>(chunk->mLoadState->load()) >= static_cast<int>(ChunkState::Loaded)
-        && !chunk->mIsEmptyClientChunk && chunk->mIsRedstoneLoaded;
-}
-
-void SafeTeleport::Task::checkChunkStatus() {
-    if (isWaitingChunkLoad()) {
-        if (isTargetChunkFullyLoaded()) {
-            updateState(TaskState::ChunkLoaded);
-        } else if (mCounter > MaxCounter) {
-            updateState(TaskState::ChunkLoadTimeout);
-        } else {
-            updateCounter();
-            sendWaitChunkLoadTip();
-            teleportToTargetPosAndTryLoadChunk();
-        }
-    }
-}
 void SafeTeleport::Task::teleportToTargetPosAndTryLoadChunk() {
     if (auto player = getPlayer()) {
+        mLeftSource = true;
         player->teleport(mTargetPos.first, mTargetPos.second);
     }
 }
 
-void SafeTeleport::Task::checkPlayerStatus() {
-    if (!getPlayer()) {
-        updateState(TaskState::TaskFailed);
-    }
+bool SafeTeleport::Task::isTargetChunkFullyLoaded() const {
+    return ChunkLoadWatcher::isChunkReady(mChunkSource, mTargetChunkPos);
 }
 
-void SafeTeleport::Task::_tryApplyDimensionFixPatch(DimensionHeightRange const& range) {
-    switch (mTargetPos.second) {
-    case 1:
-        _applyNetherFixPatch(range);
-        break;
-    default:
-        break;
+SafeTeleport::SafeTeleport(ll::thread::ServerThreadExecutor const& serverThreadExecutor)
+: mServerThreadExecutor(serverThreadExecutor),
+  mChunkLoadWatcher(std::make_unique<ChunkLoadWatcher>(serverThreadExecutor)),
+  mSearchScheduler(
+      std::make_unique<SearchScheduler>(serverThreadExecutor, TeleportSystem::getInstance().getThreadPool())
+  ) {}
+
+SafeTeleport::~SafeTeleport() {
+    mChunkLoadWatcher.reset();
+    mSearchScheduler.reset();
+    for (auto& [_, task] : mTasks) {
+        task->abort();
     }
+    mTasks.clear();
+    mQueues.clear();
 }
-void SafeTeleport::Task::_applyNetherFixPatch(DimensionHeightRange const& range) {
-    mTargetPos.first.y = range.mMax - 5; // 向下偏移 5 格，避免基岩顶部
+
+void SafeTeleport::launchTask(
+    Player&                              player,
+    DimensionPos                         targetPos,
+    long long                            charge,
+    std::optional<CooldownTable::Column> cooldown
+) {
+    auto task = std::make_shared<Task>(player, targetPos, charge, cooldown);
+    mTasks.emplace(task->mId, task);
+    handlePending(task);
 }
-void SafeTeleport::Task::_findSafePos() {
-    auto const& dangerousBlocks = getConfig().modules.tpr.dangerousBlocks;
 
-    auto& targetPos   = mTargetPos.first;
-    auto* player      = getPlayer();
-    auto& blockSource = player->getDimensionBlockSource();
+std::vector<std::string> SafeTeleport::resolveDangerousBlocks(std::unordered_set<std::string> const& names) {
+    // 关联方块：流动液体与同类伤害方块
+    static std::unordered_map<std::string, std::vector<std::string>> const RelatedBlocks = {
+        {"minecraft:water", {"minecraft:flowing_water"}                     },
+        {"minecraft:lava",  {"minecraft:flowing_lava", "minecraft:magma"}   },
+        {"minecraft:fire",  {"minecraft:soul_fire"}                         },
+    };
+
+    // 构建新集合后整体替换，线程池中进行的分析继续使用旧集合
+    auto dangerousBlocks = std::make_shared<BlockIdSet>();
+
+    std::vector<std::string> unknown;
+    auto                     resolve = [&](std::string const& name) -> bool {
+        auto block = Block::tryGetFromRegistry(name);
+        if (!block) {
+            return false;
+        }
+        // 同一方块类型的所有状态（如液体深度）均视为危险
+        block->getLegacyBlock().forEachBlockPermutation([&](Block const& permutation) {
+            dangerousBlocks->insert(permutation.getRuntimeId());
+            return true;
+        });
+        return true;
+    };
+
+    for (auto const& name : names) {
+        if (!resolve(name)) {
+            unknown.push_back(name);
+            continue;
+        }
+        if (auto iter = RelatedBlocks.find(name); iter != RelatedBlocks.end()) {
+            for (auto const& related : iter->second) {
+                resolve(related);
+            }
+        }
+    }
+    mSearchScheduler->setDangerousBlocks(std::move(dangerousBlocks));
+    return unknown;
+}
 
-    auto const& heightRange = player->getDimension().mHeightRange.get();
-    auto const  start       = heightRange.mMax;
-    auto const  end         = heightRange.mMin;
+BlockIdSet const& SafeTeleport::getDangerousBlocks() const { return mSearchScheduler->getDangerousBlocks(); }
 
-    Block* headBlock = nullptr; // 头部方块
-    Block* legBlock  = nullptr; // 腿部方块
+bool SafeTeleport::hasActiveTasks() const { return !mTasks.empty(); }
 
-    auto& y = targetPos.y;
-    y       = start; // 从最高点开始寻找
+ChunkLoadWatcher& SafeTeleport::getChunkLoadWatcher() { return *mChunkLoadWatcher; }
 
-    _tryApplyDimensionFixPatch(heightRange); // 尝试应用维度修复补丁
+bool SafeTeleport::tryAcquireChunkLoad(int dimId) {
+    auto& queue = mQueues[dimId];
+    if (!queue.mWaiting.empty() || queue.mLoading >= std::max(getConfig().modules.tpr.maxConcurrentChunkLoads, 1)) {
+        return false;
+    }
+    queue.mLoading++;
+    mMetrics.loading++;
+    return true;
+}
 
-#ifdef TPS_DEBUG
-    auto& logger = TeleportSystem::getInstance().getSelf().getLogger();
-#endif
+void SafeTeleport::releaseChunkLoad(int dimId) {
+    mQueues[dimId].mLoading--;
+    mMetrics.loading--;
+    admitQueuedTasks(dimId);
+}
 
-    while (y > end && !mAbortFlag.load()) {
-        auto block = &const_cast<Block&>(blockSource.getBlock(targetPos));
+SearchScheduler& SafeTeleport::getSearchScheduler() { return *mSearchScheduler; }
 
-        if (!headBlock && !legBlock) { // 第一次循环, 初始化
-            headBlock = block;
-            legBlock  = block;
-        }
+RejectedRegionCache& SafeTeleport::getRejectedRegions() { return mRejectedRegions; }
 
-#ifdef TPS_DEBUG
-        logger.debug("[TPR] Y: {}  Block: {}", y, block->getTypeName());
-#endif
+BiomeScreen& SafeTeleport::getBiomeScreen() { return mBiomeScreen; }
 
-        if (!block->isAir() &&                                 // 落脚点不是空气
-            !dangerousBlocks.contains(block->getTypeName()) && // 落脚点不是危险方块
-            headBlock->isAir() &&                              // 头部方块是空气
-            legBlock->isAir()                                  // 腿部方块是空气
-        ) {
-            y++; // 往上一格，当前格为落脚点方块
+NeighborhoodCoalescer& SafeTeleport::getCoalescer() { return mCoalescer; }
 
-            updateState(TaskState::FoundSafePos); // 找到安全位置
-            return;
-        }
+SafeTeleport::QueueMetrics SafeTeleport::getQueueMetrics() const { return mMetrics; }
 
-        headBlock = legBlock;
-        legBlock  = block;
-        y--;
+void SafeTeleport::handlePending(SharedTask const& task) {
+    auto player = task->getPlayer();
+    if (!player) {
+        finishTask(task);
+        return;
     }
-    updateState(TaskState::NoSafePos); // 没有找到安全位置
-}
+    mc_utils::sendText(*player, "[1/4] 任务已创建"_trl(task->mCachedLocaleCode));
 
-void SafeTeleport::Task::launchFindPosTask(ll::thread::ServerThreadExecutor const& serverThreadExecutor) {
-    ll::coro::keepThis([this]() -> ll::coro::CoroTask<> {
-        co_await ll::chrono::ticks(1); // 等待 1_tick 再开始寻找安全位置
-        _findSafePos();
-        co_return;
-    }).launch(serverThreadExecutor.getDefault());
-}
+    if (task->isTargetChunkFullyLoaded()) {
+        handleChunkLoaded(task);
+        return;
+    }
 
+    // 排队等待区块加载名额，避免同时生成大量区块
+    auto& queue = mQueues[task->mTargetPos.second];
+    queue.mWaiting.emplace_back(task->mId, Clock::now());
+    task->updateState(TaskState::Queued);
 
-SafeTeleport::SafeTeleport(ll::thread::ServerThreadExecutor const& serverThreadExecutor)
-: mServerThreadExecutor(serverThreadExecutor) {
-    mInterruptableSleep = std::make_shared<ll::coro::InterruptableSleep>();
-    mPollingAbortFlag   = std::make_shared<std::atomic_bool>(false);
-
-    ll::coro::keepThis([this, sleep = mInterruptableSleep, abortFlag = mPollingAbortFlag]() -> ll::coro::CoroTask<> {
-        while (!abortFlag->load()) {
-            co_await sleep->sleepFor(ll::chrono::ticks{10});
-            if (abortFlag->load()) break;
-            try {
-                polling();
-            } catch (...) {
-                TeleportSystem::getInstance().getSelf().getLogger().error(
-                    "An exception occurred while polling SafeTeleport tasks"
-                );
-            }
-        }
-        co_return;
-    }).launch(serverThreadExecutor.getDefault());
-}
+    mMetrics.queued++;
+    mMetrics.peakQueued = std::max(mMetrics.peakQueued, mMetrics.queued);
 
-SafeTeleport::~SafeTeleport() {
-    mPollingAbortFlag->store(true);
-    mInterruptableSleep->interrupt(true);
-    for (auto& [_, task] : mTasks) {
-        task->abort();
+    if (queue.mLoading >= std::max(getConfig().modules.tpr.maxConcurrentChunkLoads, 1)) {
+        mc_utils::sendText(
+            *player,
+            "[2/4] 目标区块加载排队中，前方还有 {0} 个任务"_trl(task->mCachedLocaleCode, queue.mWaiting.size() - 1)
+        );
     }
-    mTasks.clear();
+    admitQueuedTasks(task->mTargetPos.second);
 }
+void SafeTeleport::admitQueuedTasks(int dimId) {
+    auto&      queue  = mQueues[dimId];
+    auto const budget = std::max(getConfig().modules.tpr.maxConcurrentChunkLoads, 1);
+
+    bool admitted = false;
+    while (queue.mLoading < budget && !queue.mWaiting.empty()) {
+        auto [id, queuedAt] = queue.mWaiting.front();
+        queue.mWaiting.pop_front();
+        mMetrics.queued--;
+
+        auto iter = mTasks.find(id);
+        if (iter == mTasks.end()) {
+            continue;
+        }
+        auto task   = iter->second;
+        auto player = task->getPlayer();
+        if (task->isAborted() || !player) {
+            finishTask(task);
+            continue;
+        }
 
-void SafeTeleport::launchTask(Player& player, DimensionPos targetPos) {
-    auto task = std::make_shared<Task>(player, targetPos);
-    mTasks.emplace(task->mId, task);
-}
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - queuedAt);
+        mMetrics.admitted++;
+        mMetrics.totalWait += wait;
+        mMetrics.maxWait    = std::max(mMetrics.maxWait, wait);
+        admitted            = true;
 
-void SafeTeleport::polling() {
-    auto iter = mTasks.begin();
+        queue.mLoading++;
+        mMetrics.loading++;
+        task->updateState(TaskState::WaitingChunkLoad);
+        mc_utils::sendText(*player, "[2/4] 目标区块未加载，等待目标区块加载..."_trl(task->mCachedLocaleCode));
 
-    while (iter != mTasks.end()) {
-        auto& task = iter->second;
+        watchTargetChunk(task, DeferredLoadTimeoutTicks);
+    }
 
-        if (!task->isTaskFailed() && !task->isTaskCompleted()) {
-            task->checkPlayerStatus(); // 检查玩家是否在线
+    if (admitted) {
+        notifyQueuePositions(queue);
+    }
+}
+void SafeTeleport::notifyQueuePositions(DimensionQueue const& queue) {
+    std::size_t position = 0;
+    for (auto const& [id, _] : queue.mWaiting) {
+        auto iter = mTasks.find(id);
+        if (iter == mTasks.end()) {
+            continue;
         }
-
-        switch (task->getState()) {
-        case TaskState::Pending:
-            handlePending(task);
-            break;
-        case TaskState::WaitingChunkLoad:
-            handleWaitingChunkLoad(task);
-            break;
-        case TaskState::ChunkLoadTimeout:
-            handleChunkLoadTimeout(task);
-            break;
-        case TaskState::ChunkLoaded:
-            handleChunkLoaded(task);
-            break;
-        case TaskState::FindingSafePos:
-            break;
-        case TaskState::FoundSafePos:
-            handleFoundSafePos(task);
-            break;
-        case TaskState::NoSafePos:
-            handleNoSafePos(task);
-            break;
-        case TaskState::TaskCompleted:
-        case TaskState::TaskFailed:
-            iter = mTasks.erase(iter); // 任务完成或失败, 移除任务
-            break;
+        if (auto player = iter->second->getPlayer()) {
+            SetTitlePacket tip{SetTitlePacket::TitleType::Actionbar};
+            tip.mTitleText = "区块加载排队中，前方还有 {0} 个任务"_trl(iter->second->mCachedLocaleCode, position);
+            tip.sendTo(*player);
         }
-
-        ++iter;
+        position++;
     }
 }
-
-void SafeTeleport::handlePending(SharedTask& task) {
-    mc_utils::sendText(*task->getPlayer(), "[1/4] 任务已创建"_trl(task->mCachedLocaleCode));
-
-    if (task->isTargetChunkFullyLoaded()) {
-        task->updateState(TaskState::ChunkLoaded);
+void SafeTeleport::watchTargetChunk(SharedTask const& task, int timeoutTicks) {
+    // 区块就绪的当 tick 继续，等待期间不再轮询
+    mChunkLoadWatcher->watch(
+        task->mChunkSource,
+        task->mTargetChunkPos,
+        timeoutTicks,
+        [this, id = task->mId, dimId = task->mTargetPos.second](bool loaded, std::shared_ptr<LevelChunk> chunk) {
+            if (auto iter = mTasks.find(id); iter != mTasks.end()) {
+                iter->second->mTargetChunk = std::move(chunk); // 继续持有到查找结束
+            }
+            handleChunkWatchResult(id, dimId, loaded);
+        },
+        [this, id = task->mId](int waited, int total) {
+            auto iter = mTasks.find(id);
+            if (iter == mTasks.end()) {
+                return;
+            }
+            auto& task = iter->second;
+            task->sendWaitChunkLoadTip(waited, total);
+            if (task->mLeftSource) {
+                task->teleportToTargetPosAndTryLoadChunk(); // 保持玩家在目标位置，避免坠落
+            }
+        }
+    );
+}
+void SafeTeleport::handleChunkWatchResult(TaskId id, int dimId, bool loaded) {
+    if (auto iter = mTasks.find(id); !loaded && iter != mTasks.end()) {
+        auto task = iter->second;
+        if (!task->isAborted() && task->getPlayer() && !task->mLeftSource) {
+            // 附近没有玩家时 Deferred 加载可能不推进，回退为传送玩家到目标位置加载区块（继续占用加载名额）
+            task->teleportToTargetPosAndTryLoadChunk();
+            watchTargetChunk(task, ChunkLoadTimeoutTicks);
+            return;
+        }
+    }
+    mQueues[dimId].mLoading--;
+    mMetrics.loading--;
+    handleChunkLoadResult(id, loaded);
+    admitQueuedTasks(dimId);
+}
+void SafeTeleport::handleChunkLoadResult(TaskId id, bool loaded) {
+    auto iter = mTasks.find(id);
+    if (iter == mTasks.end()) {
+        return;
+    }
+    auto task = iter->second;
+    if (task->isAborted() || !task->getPlayer()) {
+        finishTask(task);
+        return;
+    }
+    if (loaded) {
+        handleChunkLoaded(task);
     } else {
-        task->updateState(TaskState::WaitingChunkLoad);
-        mc_utils::sendText(
-            *task->getPlayer(),
-            "[2/4] 目标区块未加载，等待目标区块加载..."_trl(task->mCachedLocaleCode)
-        );
+        handleChunkLoadTimeout(task);
     }
 }
-void SafeTeleport::handleWaitingChunkLoad(SharedTask& task) { task->checkChunkStatus(); }
-void SafeTeleport::handleChunkLoadTimeout(SharedTask& task) {
+void SafeTeleport::handleChunkLoadTimeout(SharedTask const& task) {
+    task->updateState(TaskState::ChunkLoadTimeout);
     mc_utils::sendText(*task->getPlayer(), "[2/4] 目标区块加载超时，正在返回原位置..."_trl(task->mCachedLocaleCode));
     task->rollback();
     task->updateState(TaskState::TaskFailed);
+    finishTask(task);
 }
-void SafeTeleport::handleChunkLoaded(SharedTask& task) {
+void SafeTeleport::handleChunkLoaded(SharedTask const& task) {
+    task->updateState(TaskState::ChunkLoaded);
     mc_utils::sendText(*task->getPlayer(), "[3/4] 区块已加载，正在寻找安全位置..."_trl(task->mCachedLocaleCode));
-    task->launchFindPosTask(mServerThreadExecutor);
+
+    if (!task->mTargetChunk) {
+        task->mTargetChunk =
+            task->mChunkSource.getOrLoadChunk(task->mTargetChunkPos, ::ChunkSource::LoadMode::None, true);
+    }
+
     task->updateState(TaskState::FindingSafePos);
+    mSearchScheduler->submit(
+        task->mTargetPos.second,
+        task->mTargetPos.first,
+        [this, id = task->mId](std::optional<Vec3> result, bool chunkLost) {
+            auto iter = mTasks.find(id);
+            if (iter == mTasks.end()) {
+                return;
+            }
+            auto task = iter->second;
+            if (task->isAborted() || !task->getPlayer()) {
+                finishTask(task);
+                return;
+            }
+            if (chunkLost) {
+                handleChunkLoadTimeout(task); // 目标区块在查找期间不可用，按超时回退，不记录拒绝区域
+            } else if (result) {
+                task->mTargetPos.first = *result;
+                task->updateState(TaskState::FoundSafePos); // 找到安全位置
+                handleFoundSafePos(task);
+            } else {
+                task->updateState(TaskState::NoSafePos); // 没有找到安全位置
+                handleNoSafePos(task);
+            }
+        },
+        std::move(task->mTargetChunk)
+    );
 }
 
-void SafeTeleport::handleFoundSafePos(SharedTask& task) {
+void SafeTeleport::handleFoundSafePos(SharedTask const& task) {
     mc_utils::sendText(*task->getPlayer(), "[4/4] 安全位置已找到，正在传送..."_trl(task->mCachedLocaleCode));
     task->commit();
     task->updateState(TaskState::TaskCompleted);
+    finishTask(task);
 }
-void SafeTeleport::handleNoSafePos(SharedTask& task) {
-    mc_utils::sendText(*task->getPlayer(), "[3/4] 未找到安全位置，正在返回原位置..."_trl(task->mCachedLocaleCode));
-    task->rollback();
+void SafeTeleport::handleNoSafePos(SharedTask const& task) {
+    auto const& [pos, dimId] = task->mTargetPos;
+    auto const x             = static_cast<int>(std::floor(pos.x));
+    auto const z             = static_cast<int>(std::floor(pos.z));
+    if (getConfig().modules.tpr.rejectedRegions.enable) {
+        mRejectedRegions.reject(dimId, x, z);
+    }
+    mCoalescer.forget(dimId, x, z); // 不再向此邻域分配请求
+    if (task->mLeftSource) {
+        mc_utils::sendText(*task->getPlayer(), "[3/4] 未找到安全位置，正在返回原位置..."_trl(task->mCachedLocaleCode));
+        task->rollback();
+    } else {
+        mc_utils::sendText(*task->getPlayer(), "[3/4] 未找到安全位置"_trl(task->mCachedLocaleCode));
+    }
     task->updateState(TaskState::TaskFailed);
+    finishTask(task);
 }
 
+void SafeTeleport::finishTask(SharedTask const& task) { mTasks.erase(task->mId); }
+
 
 } // namespace ltps::tpr
\ No newline at end of file
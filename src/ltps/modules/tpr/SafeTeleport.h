@@ -1,21 +1,32 @@
 #pragma once
 #include "ltps/Global.h"
+#include "ltps/common/Cooldown.h"
+#include "ltps/modules/tpr/BiomeScreen.h"
+#include "ltps/modules/tpr/BlockIdSet.h"
+#include "ltps/modules/tpr/ChunkLoadWatcher.h"
+#include "ltps/modules/tpr/NeighborhoodCoalescer.h"
+#include "ltps/modules/tpr/RejectedRegionCache.h"
+#include "ltps/modules/tpr/SearchScheduler.h"
 #include "mc/deps/core/math/Vec3.h"
 #include "mc/deps/ecs/WeakEntityRef.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <ll/api/coro/CoroTask.h>
-#include <ll/api/coro/InterruptableSleep.h>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <ll/api/thread/ServerThreadExecutor.h>
-#include <mc/network/packet/SetTitlePacket.h>
 #include <mc/world/level/ChunkPos.h>
 #include <utility>
+#include <vector>
 
 
-class DimensionHeightRange;
-namespace mce {
-class UUID;
-}
 class ChunkSource;
+class LevelChunk;
 
 namespace ltps::tpr {
 
@@ -28,13 +39,14 @@ class SafeTeleport {
         // 初始状态
         Pending, // 任务刚创建，等待开始处理
 
-        // 区块加载阶段（轮询检查）
+        // 区块加载阶段（ChunkLoadWatcher 回调）
+        Queued,           // 排队等待区块加载名额
         WaitingChunkLoad, // 等待区块加载
         ChunkLoadTimeout, // 区块加载超时
         ChunkLoaded,      // 区块加载完成
 
-        // 安全位置查找阶段（任务自身协程处理）
-        FindingSafePos, // 正在异步查找安全位置
+        // 安全位置查找阶段
+        FindingSafePos, // 正在查找安全位置
         FoundSafePos,   // 成功找到安全位置
         NoSafePos,      // 未找到安全位置
 
@@ -44,22 +56,20 @@ class SafeTeleport {
     };
 
     class Task {
-        static inline constexpr short MaxCounter = 64;                                  // 最大计数器值
-        TaskId const                  mId;                                              // 任务ID
-        WeakRef<EntityContext>        mWeakPlayer;                                      // 玩家
-        ChunkSource&                  mChunkSource;                                     // 区块源
-        ChunkPos                      mTargetChunkPos;                                  // 目标区块位置
-        std::string const             mCachedLocaleCode;                                // 玩家语言代码
-        DimensionPos const            mSourcePos;                                       // 原位置
-        DimensionPos                  mTargetPos;                                       // 目标位置
-        TaskState                     mState{TaskState::Pending};                       // 任务状态
-        short                         mCounter{0};                                      // 计数器
-        SetTitlePacket                mTipPacket{SetTitlePacket::TitleType::Actionbar}; // 提示包
-        std::atomic<bool>             mAbortFlag{false};                                // 终止标志
-
-        void _findSafePos();
-        void _tryApplyDimensionFixPatch(DimensionHeightRange const& range); // 尝试应用维度修复补丁
-        void _applyNetherFixPatch(DimensionHeightRange const& range);
+        TaskId const                               mId;                        // 任务ID
+        WeakRef<EntityContext>                     mWeakPlayer;                // 玩家
+        ChunkSource&                               mChunkSource;               // 区块源
+        ChunkPos                                   mTargetChunkPos;            // 目标区块位置
+        std::shared_ptr<LevelChunk>                mTargetChunk;               // 持有的目标区块，交给查找后释放
+        std::string const                          mCachedLocaleCode;          // 玩家语言代码
+        DimensionPos const                         mSourcePos;                 // 原位置
+        DimensionPos                               mTargetPos;                 // 目标位置
+        long long const                            mCharge;                    // 已扣除的费用
+        std::optional<CooldownTable::Column> const mCooldown;                  // 已设置的冷却
+        TaskState                                  mState{TaskState::Pending}; // 任务状态
+        std::atomic<bool>                          mAbortFlag{false};          // 终止标志
+        bool                                       mLeftSource{false};         // 是否已传送玩家加载区块
+
         friend SafeTeleport;
 
     public:
@@ -69,9 +79,15 @@ class SafeTeleport {
         Task&       operator=(Task&&) = delete;
         TPSAPI bool operator==(const Task& other) const;
 
-        TPSAPI explicit Task(Player& player, DimensionPos targetPos);
+        TPSAPI explicit Task(
+            Player&                              player,
+            DimensionPos                         targetPos,
+            long long                            charge   = 0,
+            std::optional<CooldownTable::Column> cooldown = std::nullopt
+        );
 
         TPSNDAPI bool isPending() const;
+        TPSNDAPI bool isQueued() const;
         TPSNDAPI bool isWaitingChunkLoad() const;
         TPSNDAPI bool isChunkLoadTimeout() const;
         TPSNDAPI bool isChunkLoaded() const;
@@ -90,45 +106,101 @@ class SafeTeleport {
 
         TPSAPI void updateState(TaskState state);
 
-        TPSAPI void updateCounter();
-
-        TPSAPI void sendWaitChunkLoadTip();
+        TPSAPI void sendWaitChunkLoadTip(int ticksWaited, int timeoutTicks) const;
 
         TPSAPI void abort();
 
         TPSAPI void rollback() const;
 
-        TPSAPI void commit() const;
+        TPSAPI void commit() const; // 传送被分发队列丢弃时返回原位置并退还费用与冷却
 
-        TPSAPI void checkChunkStatus();                   // 检查目标区块状态
-        TPSAPI void checkPlayerStatus();                  // 检查玩家是否在线
         TPSAPI void teleportToTargetPosAndTryLoadChunk(); // 传送到目标位置并尝试加载区块
-        TPSAPI void launchFindPosTask(ll::thread::ServerThreadExecutor const& serverThreadExecutor);
     };
     using SharedTask = std::shared_ptr<Task>;
 
+    using Clock = std::chrono::steady_clock;
+
+    // 区块加载排队统计
+    struct QueueMetrics {
+        std::size_t               queued{0};     // 当前排队任务数
+        std::size_t               loading{0};    // 当前加载中的区块数
+        std::size_t               peakQueued{0}; // 排队峰值
+        std::uint64_t             admitted{0};   // 累计放行任务数
+        std::chrono::milliseconds totalWait{0};  // 累计排队时长
+        std::chrono::milliseconds maxWait{0};    // 最长排队时长
+    };
+
 
     TPSAPI explicit SafeTeleport(ll::thread::ServerThreadExecutor const& serverThreadExecutor);
     TPSAPI ~SafeTeleport();
 
-    TPSAPI void launchTask(Player& player, DimensionPos targetPos);
+    // charge / cooldown 为请求已扣除的费用与冷却，传送被分发队列丢弃时退还
+    TPSAPI void launchTask(
+        Player&                              player,
+        DimensionPos                         targetPos,
+        long long                            charge   = 0,
+        std::optional<CooldownTable::Column> cooldown = std::nullopt
+    );
 
+    // 将配置的危险方块名解析为运行时 Id（含流动液体等关联方块），返回未识别的方块名
+    TPSAPI std::vector<std::string> resolveDangerousBlocks(std::unordered_set<std::string> const& names);
 
-private:
-    void polling(); // 轮询任务状态
+    TPSNDAPI BlockIdSet const& getDangerousBlocks() const;
+
+    TPSNDAPI bool hasActiveTasks() const;
+
+    TPSNDAPI ChunkLoadWatcher& getChunkLoadWatcher();
+
+    // 占用一个区块加载名额（有任务排队时失败），加载结束后调用 releaseChunkLoad 归还
+    TPSNDAPI bool tryAcquireChunkLoad(int dimId);
 
-    void handlePending(SharedTask& task);
-    void handleWaitingChunkLoad(SharedTask& task);
-    void handleChunkLoadTimeout(SharedTask& task);
-    void handleChunkLoaded(SharedTask& task);
-    void handleFoundSafePos(SharedTask& task);
-    void handleNoSafePos(SharedTask& task);
+    TPSAPI void releaseChunkLoad(int dimId);
 
-    std::unordered_map<TaskId, SharedTask> mTasks;
+    TPSNDAPI QueueMetrics getQueueMetrics() const;
+
+    TPSNDAPI SearchScheduler& getSearchScheduler();
+
+    // 未找到安全位置的区域，随机选点时跳过
+    TPSNDAPI RejectedRegionCache& getRejectedRegions();
+
+    TPSNDAPI BiomeScreen& getBiomeScreen();
+
+    // 最近选中的区块邻域（tpr.coalesce）
+    TPSNDAPI NeighborhoodCoalescer& getCoalescer();
+
+
+private:
+    static inline constexpr int DeferredLoadTimeoutTicks = 200; // 不移动玩家的区块加载超时（tick）
+    static inline constexpr int ChunkLoadTimeoutTicks    = 640; // 传送玩家后的区块加载超时（tick）
+
+    // 每个维度的区块加载队列（FIFO）
+    struct DimensionQueue {
+        std::deque<std::pair<TaskId, Clock::time_point>> mWaiting;
+        int                                              mLoading{0};
+    };
 
-    ll::thread::ServerThreadExecutor const&       mServerThreadExecutor;
-    std::shared_ptr<ll::coro::InterruptableSleep> mInterruptableSleep{nullptr};
-    std::shared_ptr<std::atomic_bool>             mPollingAbortFlag{nullptr};
+    void handlePending(SharedTask const& task);
+    void admitQueuedTasks(int dimId);
+    void notifyQueuePositions(DimensionQueue const& queue);
+    void watchTargetChunk(SharedTask const& task, int timeoutTicks);
+    void handleChunkWatchResult(TaskId id, int dimId, bool loaded);
+    void handleChunkLoadResult(TaskId id, bool loaded);
+    void handleChunkLoadTimeout(SharedTask const& task);
+    void handleChunkLoaded(SharedTask const& task);
+    void handleFoundSafePos(SharedTask const& task);
+    void handleNoSafePos(SharedTask const& task);
+    void finishTask(SharedTask const& task);
+
+    std::unordered_map<TaskId, SharedTask>  mTasks;
+    std::unordered_map<int, DimensionQueue> mQueues;
+    QueueMetrics                            mMetrics;
+    RejectedRegionCache                     mRejectedRegions;
+    BiomeScreen                             mBiomeScreen;
+    NeighborhoodCoalescer                   mCoalescer;
+
+    ll::thread::ServerThreadExecutor const& mServerThreadExecutor;
+    std::unique_ptr<ChunkLoadWatcher>       mChunkLoadWatcher; // 析构时先行销毁，不再回调
+    std::unique_ptr<SearchScheduler>        mSearchScheduler;
 };
 
 } // namespace ltps::tpr
@@ -0,0 +1,359 @@
+#include "SearchScheduler.h"
+#include "ChunkLoadWatcher.h"
+#include "ll/api/chrono/GameChrono.h"
+#include "ll/api/service/Bedrock.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
+#include <algorithm>
+#include <cmath>
+#include <ll/api/coro/CoroTask.h>
+#include <mc/deps/game_refs/WeakRef.h>
+#include <mc/world/level/BlockPos.h>
+#include <mc/world/level/BlockSource.h>
+#include <mc/world/level/Level.h>
+#include <mc/world/level/block/BedrockBlocks.h>
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <mc/world/level/chunk/SubChunk.h>
+#include <mc/world/level/chunk/SubChunkBlockStorage.h>
+#include <mc/world/level/dimension/Dimension.h>
+#include <utility>
+
+
+namespace ltps::tpr {
+
+
+namespace {
+
+// 开始复制单列快照：从高度图（或查找起点）向下复制 depth 格，方块由 captureSections 分段复制
+ColumnSnapshot beginColumn(
+    BlockSource&                blockSource,
+    int                         x,
+    int                         z,
+    DimensionHeightRange const& range,
+    int                         startY,
+    int                         depth
+) {
+    auto const minY      = static_cast<int>(range.mMin);
+    auto const heightmap = static_cast<int>(blockSource.getHeightmap(x, z));
+    auto const topY      = std::min(heightmap <= startY ? heightmap : startY + 1, static_cast<int>(range.mMax));
+    auto const bottomY   = std::max(minY, topY - depth);
+
+    return ColumnSnapshot{x, z, minY, range.mMax, bottomY, topY, heightmap, BedrockBlocks::mAir->getRuntimeId()};
+}
+
+// 从 section 起逐个子区块复制，空子区块只做标记；预算用尽时返回 false，section 为下次继续的位置
+bool captureSections(BlockSource& blockSource, LevelChunk& chunk, ColumnSnapshot& snapshot, int& section, int& budget) {
+    auto const minY = snapshot.getMinY();
+    auto const topY = snapshot.getTopY();
+    auto const x    = snapshot.getX();
+    auto const z    = snapshot.getZ();
+
+    for (; minY + section * SafePosFinder::SectionHeight < topY; ++section) {
+        if (budget <= 0) {
+            return false;
+        }
+        budget--;
+        // 未分配的子区块即为全空气
+        auto subChunk = chunk.getSubChunk(static_cast<short>(section));
+        if (!subChunk || subChunk->mBlocks->get()->isUniform(*BedrockBlocks::mAir)) {
+            snapshot.markSectionEmpty(section);
+            continue;
+        }
+
+        auto const begin = std::max(snapshot.getBottomY(), minY + section * SafePosFinder::SectionHeight);
+        auto const end   = std::min(topY, minY + (section + 1) * SafePosFinder::SectionHeight);
+        for (int y = begin; y < end; ++y) {
+            snapshot.set(y, blockSource.getBlock(BlockPos{x, y, z}).getRuntimeId());
+        }
+        budget -= end - begin;
+    }
+    return true;
+}
+
+} // namespace
+
+
+SearchScheduler::SearchScheduler(
+    ll::thread::ServerThreadExecutor const& serverThreadExecutor,
+    ll::thread::ThreadPoolExecutor&         threadPool
+)
+: mServerThreadExecutor(serverThreadExecutor),
+  mThreadPool(threadPool),
+  mDangerousBlocks(std::make_shared<BlockIdSet const>()) {
+    mInterruptableSleep = std::make_shared<ll::coro::InterruptableSleep>();
+    mAbortFlag          = std::make_shared<std::atomic_bool>(false);
+
+    ll::coro::keepThis([this, sleep = mInterruptableSleep, abortFlag = mAbortFlag]() -> ll::coro::CoroTask<> {
+        while (!abortFlag->load()) {
+            if (mJobs.empty()) {
+                co_await sleep->sleepFor(ll::chrono::ticks{IdleSleepTicks});
+            } else {
+                co_await ll::chrono::ticks(1);
+            }
+            if (abortFlag->load()) break;
+            try {
+                _tick();
+            } catch (...) {
+                TeleportSystem::getInstance().getSelf().getLogger().error(
+                    "An exception occurred while searching for safe positions"
+                );
+            }
+        }
+        co_return;
+    }).launch(serverThreadExecutor.getDefault());
+}
+
+SearchScheduler::~SearchScheduler() {
+    mAbortFlag->store(true); // 线程池中的分析结果不再回调
+    mInterruptableSleep->interrupt(true);
+    mJobs.clear();
+}
+
+int SearchScheduler::getSearchStartY(int dimId, DimensionHeightRange const& range) {
+    switch (dimId) {
+    case 1:
+        return range.mMax - 5; // 下界：向下偏移 5 格，避免基岩顶部
+    default:
+        return range.mMax; // 从最高点开始寻找
+    }
+}
+
+void SearchScheduler::setDangerousBlocks(std::shared_ptr<BlockIdSet const> dangerousBlocks) {
+    mDangerousBlocks = std::move(dangerousBlocks);
+}
+
+BlockIdSet const& SearchScheduler::getDangerousBlocks() const { return *mDangerousBlocks; }
+
+void SearchScheduler::submit(int dimId, Vec3 const& origin, Callback callback, std::shared_ptr<LevelChunk> chunk) {
+    auto level = ll::service::getLevel();
+    if (!level) {
+        callback(std::nullopt, true);
+        return;
+    }
+    auto dimension = level->getDimension(dimId).lock();
+    if (!dimension) {
+        callback(std::nullopt, true);
+        return;
+    }
+
+    Job job{
+        .mId        = mNextJobId++,
+        .mDimId     = dimId,
+        .mOriginX   = static_cast<int>(std::floor(origin.x)),
+        .mOriginZ   = static_cast<int>(std::floor(origin.z)),
+        .mStartY    = getSearchStartY(dimId, dimension->mHeightRange.get()),
+        .mHeldChunk = std::move(chunk),
+        .mCallback  = std::move(callback),
+    };
+
+    bool const wasIdle = mJobs.empty();
+    mJobs.push_back(std::move(job));
+    if (wasIdle) {
+        mInterruptableSleep->interrupt(); // 唤醒空闲协程
+    }
+}
+
+std::size_t SearchScheduler::size() const { return mJobs.size(); }
+
+void SearchScheduler::_tick() {
+    auto level = ll::service::getLevel();
+    if (!level || mJobs.empty()) {
+        return;
+    }
+
+    auto budget = std::max(getConfig().modules.tpr.searchBlockBudgetPerTick, 1);
+
+    // 轮转起点，平均分配本 tick 的复制预算（分析中的查找不占用预算）
+    auto const count    = mJobs.size();
+    auto const copying  = std::count_if(mJobs.begin(), mJobs.end(), [](Job const& job) { return !job.mAnalyzing; });
+    auto const share    = std::max(budget / static_cast<int>(std::max<std::ptrdiff_t>(copying, 1)), 1);
+    for (std::size_t k = 0; k < count && budget > 0; ++k) {
+        auto& job = mJobs[(mCursor + k) % count];
+        if (job.mAnalyzing || job.mDone) {
+            continue;
+        }
+
+        auto dimension = level->getDimension(job.mDimId).lock();
+        if (!dimension) {
+            job.mDone      = true; // 维度已卸载
+            job.mChunkLost = true;
+            continue;
+        }
+
+        auto slice = std::min(share, budget);
+        budget    -= slice;
+        _capture(job, dimension->getBlockSourceFromMainChunkSource(), dimension->mHeightRange.get(), slice);
+        budget += std::max(slice, 0); // 归还未用完的预算
+    }
+    mCursor = (mCursor + 1) % count;
+
+    // 回调中可能再次 submit，统一在移除完成的查找后调用
+    std::vector<std::pair<Callback, bool>> finished;
+    std::erase_if(mJobs, [&](Job& job) {
+        if (!job.mDone) {
+            return false;
+        }
+        finished.emplace_back(std::move(job.mCallback), job.mChunkLost);
+        return true;
+    });
+    for (auto& [callback, chunkLost] : finished) {
+        callback(std::nullopt, chunkLost);
+    }
+}
+
+void SearchScheduler::_capture(Job& job, BlockSource& blockSource, DimensionHeightRange const& range, int& budget) {
+    auto const& cfg     = getConfig().modules.tpr.neighborSearch;
+    auto const& offsets = SafePosFinder::getSpiralOffsets();
+
+    // 目标列没有安全位置时，在已加载的区块内螺旋向外尝试其它列
+    auto const maxRadius  = cfg.allowAdjacentChunks ? SafePosFinder::ChunkWidth : SafePosFinder::ChunkWidth - 1;
+    auto const limit      = static_cast<std::size_t>(SafePosFinder::spiralCount(maxRadius));
+    auto const maxColumns = 1 + std::max(cfg.maxColumns, 0);
+    auto const chunkX     = job.mOriginX >> 4;
+    auto const chunkZ     = job.mOriginZ >> 4;
+
+    // 相邻区块未加载时跳过该列；目标区块不可用时放弃查找，交由调用方按超时处理
+    auto const skipColumn = [&](int x, int z) {
+        if ((x >> 4) == chunkX && (z >> 4) == chunkZ) {
+            job.mChunkLost = true;
+            job.mDone      = true;
+            return false;
+        }
+        return true;
+    };
+
+    while (budget > 0 && job.mBatch.size() < BatchColumns) {
+        LevelChunk* chunk = nullptr;
+        if (job.mPartial) {
+            auto const& snapshot = job.mPartial->mSnapshot;
+            chunk                = blockSource.getChunkAt(BlockPos{snapshot.getX(), 0, snapshot.getZ()});
+            if (!chunk || !ChunkLoadWatcher::isChunkReady(*chunk)) {
+                auto const x = snapshot.getX();
+                auto const z = snapshot.getZ();
+                job.mPartial.reset(); // 两次复制之间区块被卸载
+                if (!skipColumn(x, z)) return;
+                continue;
+            }
+        } else {
+            PendingColumn next{};
+            if (!job.mDeeper.empty()) {
+                next = job.mDeeper.front();
+                job.mDeeper.pop_front();
+            } else {
+                if (job.mColumns >= maxColumns || job.mSpiralIndex >= limit) {
+                    job.mExhausted = true;
+                    break;
+                }
+                auto [dx, dz] = offsets[job.mSpiralIndex++];
+                next          = {job.mOriginX + dx, job.mOriginZ + dz, 0};
+                if (!cfg.allowAdjacentChunks && ((next.x >> 4) != chunkX || (next.z >> 4) != chunkZ)) {
+                    continue;
+                }
+            }
+
+            chunk = blockSource.getChunkAt(BlockPos{next.x, 0, next.z});
+            if (!chunk || !ChunkLoadWatcher::isChunkReady(*chunk)) {
+                if (!skipColumn(next.x, next.z)) return; // 区块未加载或已被卸载
+                continue;
+            }
+            if (next.stage == 0) {
+                job.mColumns++;
+            }
+
+            auto snapshot = beginColumn(blockSource, next.x, next.z, range, job.mStartY, CaptureDepths[next.stage]);
+            auto section  = (snapshot.getBottomY() - snapshot.getMinY()) / SafePosFinder::SectionHeight;
+            job.mPartial = PartialColumn{std::move(snapshot), next.stage, section};
+        }
+
+        auto& partial = *job.mPartial;
+        if (!captureSections(blockSource, *chunk, partial.mSnapshot, partial.mNextSection, budget)) {
+            break; // 预算用尽，下个 tick 从断点继续
+        }
+        job.mBatch.push_back(std::move(partial.mSnapshot));
+        job.mBatchStages.push_back(partial.mStage);
+        job.mPartial.reset();
+    }
+
+    bool const drained = job.mExhausted && job.mDeeper.empty() && !job.mPartial;
+    if (!job.mBatch.empty() && (job.mBatch.size() >= BatchColumns || drained)) {
+        _dispatch(job);
+    } else if (job.mBatch.empty() && drained) {
+        job.mDone = true; // 没有安全位置
+    }
+}
+
+void SearchScheduler::_dispatch(Job& job) {
+    job.mAnalyzing = true;
+
+    auto batch  = std::make_shared<std::vector<ColumnSnapshot>>(std::move(job.mBatch));
+    auto stages = std::make_shared<std::vector<int>>(std::move(job.mBatchStages));
+    job.mBatch.clear();
+    job.mBatchStages.clear();
+
+    mThreadPool.execute([this,
+                         id              = job.mId,
+                         startY          = job.mStartY,
+                         batch           = std::move(batch),
+                         stages          = std::move(stages),
+                         dangerousBlocks = mDangerousBlocks,
+                         abortFlag       = mAbortFlag,
+                         &serverThread   = mServerThreadExecutor]() {
+        auto analysis = std::make_shared<SnapshotAnalysis>(findInSnapshots(*batch, startY, *dangerousBlocks));
+        if (abortFlag->load()) return; // 模块已禁用，服务器线程执行器可能已销毁
+
+        serverThread.execute([this, id, batch, stages, analysis, abortFlag]() {
+            if (abortFlag->load()) return; // 已析构
+            _onAnalyzed(id, *batch, *stages, *analysis);
+        });
+    });
+}
+
+void SearchScheduler::_onAnalyzed(
+    JobId                              id,
+    std::vector<ColumnSnapshot> const& batch,
+    std::vector<int> const&            stages,
+    SnapshotAnalysis const&            analysis
+) {
+    auto iter = std::find_if(mJobs.begin(), mJobs.end(), [id](Job const& job) { return job.mId == id; });
+    if (iter == mJobs.end()) {
+        return;
+    }
+    iter->mAnalyzing = false;
+
+    if (analysis.found) {
+        auto const& snapshot = batch[analysis.found->index];
+        _finish(
+            id,
+            Vec3{
+                static_cast<float>(snapshot.getX()) + 0.5f, // 方块中心
+                static_cast<float>(analysis.found->y),
+                static_cast<float>(snapshot.getZ()) + 0.5f
+            }
+        );
+        return;
+    }
+
+    // 部分快照内没有安全位置的列，按原顺序加深复制
+    for (auto index : analysis.incomplete) {
+        if (auto stage = stages[index] + 1; stage < static_cast<int>(CaptureDepths.size())) {
+            iter->mDeeper.push_back({batch[index].getX(), batch[index].getZ(), stage});
+        }
+    }
+    if (iter->mExhausted && iter->mDeeper.empty()) {
+        _finish(id, std::nullopt);
+    }
+}
+
+void SearchScheduler::_finish(JobId id, std::optional<Vec3> result) {
+    auto iter = std::find_if(mJobs.begin(), mJobs.end(), [id](Job const& job) { return job.mId == id; });
+    if (iter == mJobs.end()) {
+        return;
+    }
+    auto callback = std::move(iter->mCallback);
+    mJobs.erase(iter); // 释放持有的目标区块
+    callback(result, false);
+}
+
+
+} // namespace ltps::tpr
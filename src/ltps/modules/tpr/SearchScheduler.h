@@ -0,0 +1,130 @@
+#pragma once
+#include "ltps/Global.h"
+#include "ltps/modules/tpr/BlockIdSet.h"
+#include "ltps/modules/tpr/ColumnSnapshot.h"
+#include "mc/deps/core/math/Vec3.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <ll/api/coro/InterruptableSleep.h>
+#include <ll/api/thread/ServerThreadExecutor.h>
+#include <ll/api/thread/ThreadPoolExecutor.h>
+#include <memory>
+#include <optional>
+#include <vector>
+
+
+class BlockSource;
+class DimensionHeightRange;
+class LevelChunk;
+
+namespace ltps::tpr {
+
+
+/**
+ * @brief 安全位置查找调度
+ * 服务器线程按列复制方块快照，所有查找共享每 tick 的复制预算（tpr.searchBlockBudgetPerTick），按轮转平均分配，
+ * 预算用尽时复制到一半的列在下个 tick 继续；
+ * 每批快照交给线程池分析，结果回到服务器线程，未找到时继续复制下一批列。
+ * 查找期间持有目标区块（包括线程池分析与加深复制），目标区块仍不可用时以 chunkLost 结束，不视为没有安全位置。
+ */
+class SearchScheduler final {
+public:
+    using JobId    = std::uint64_t;
+    // result: 玩家脚部坐标（方块中心）；chunkLost: 目标区块在查找期间不可用，结果不代表没有安全位置
+    using Callback = std::function<void(std::optional<Vec3> result, bool chunkLost)>;
+
+private:
+    // 待复制的列，stage 为复制深度档位（CaptureDepths 下标）
+    struct PendingColumn {
+        int x;
+        int z;
+        int stage;
+    };
+
+    // 复制到一半的列，预算用尽时保留，下个 tick 从 mNextSection 继续
+    struct PartialColumn {
+        ColumnSnapshot mSnapshot;
+        int            mStage;
+        int            mNextSection;
+    };
+
+    struct Job {
+        JobId                        mId;
+        int                          mDimId;
+        int                          mOriginX;
+        int                          mOriginZ;
+        int                          mStartY;
+        std::size_t                  mSpiralIndex{0}; // 下一个螺旋偏移
+        int                          mColumns{0};     // 已开始查找的列数
+        std::deque<PendingColumn>    mDeeper;         // 需要复制更深范围的列，优先于新列
+        std::vector<ColumnSnapshot>  mBatch;          // 正在复制的一批列
+        std::vector<int>             mBatchStages;
+        std::optional<PartialColumn> mPartial;        // 正在复制的列
+        bool                         mAnalyzing{false};
+        bool                         mExhausted{false}; // 螺旋偏移已用尽
+        bool                         mDone{false};
+        bool                         mChunkLost{false}; // 目标区块不可用
+        std::shared_ptr<LevelChunk>  mHeldChunk;        // 持有目标区块，查找结束时释放
+        Callback                     mCallback;
+    };
+
+    static inline constexpr int         IdleSleepTicks = 1200;
+    static inline constexpr std::size_t BatchColumns   = 8; // 每批分析的列数
+
+    // 每列从高度图向下复制的深度，部分快照内没有安全位置时逐档加深
+    static inline constexpr std::array<int, 3> CaptureDepths = {16, 64, 1 << 16};
+
+    ll::thread::ServerThreadExecutor const&       mServerThreadExecutor;
+    ll::thread::ThreadPoolExecutor&               mThreadPool;
+    std::shared_ptr<BlockIdSet const>             mDangerousBlocks;
+    std::vector<Job>                              mJobs;
+    JobId                                         mNextJobId{0};
+    std::size_t                                   mCursor{0}; // 轮转起点
+    std::shared_ptr<ll::coro::InterruptableSleep> mInterruptableSleep{nullptr};
+    std::shared_ptr<std::atomic_bool>             mAbortFlag{nullptr};
+
+    void _tick();
+    void _capture(Job& job, BlockSource& blockSource, DimensionHeightRange const& range, int& budget);
+    void _dispatch(Job& job);
+    void _onAnalyzed(
+        JobId                              id,
+        std::vector<ColumnSnapshot> const& batch,
+        std::vector<int> const&            stages,
+        SnapshotAnalysis const&            analysis
+    );
+    void _finish(JobId id, std::optional<Vec3> result);
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(SearchScheduler);
+
+    TPSAPI explicit SearchScheduler(
+        ll::thread::ServerThreadExecutor const& serverThreadExecutor,
+        ll::thread::ThreadPoolExecutor&         threadPool
+    );
+    TPSAPI ~SearchScheduler();
+
+    // 维度安全位置查找起点（下界避开基岩顶部）
+    TPSNDAPI static int getSearchStartY(int dimId, DimensionHeightRange const& range);
+
+    // 替换危险方块集合，进行中的分析继续使用旧集合
+    TPSAPI void setDangerousBlocks(std::shared_ptr<BlockIdSet const> dangerousBlocks);
+
+    TPSNDAPI BlockIdSet const& getDangerousBlocks() const;
+
+    /**
+     * @brief 提交查找（目标列优先，其次在已加载区块内螺旋向外的其它列）
+     * @param origin 目标坐标，仅使用 x / z
+     * @param callback 完成后在服务器线程回调
+     * @param chunk 目标区块，查找结束前一直持有，避免复制与分析之间被卸载
+     */
+    TPSAPI void submit(int dimId, Vec3 const& origin, Callback callback, std::shared_ptr<LevelChunk> chunk = nullptr);
+
+    TPSNDAPI std::size_t size() const;
+};
+
+
+} // namespace ltps::tpr
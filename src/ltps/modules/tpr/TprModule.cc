@@ -5,8 +5,13 @@
 #include "ltps/TeleportSystem.h"
 #include "ltps/base/Config.h"
 #include "ltps/common/PriceCalculate.h"
+#include "ltps/common/RateLimiter.h"
 #include "ltps/utils/McUtils.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
 #include <ll/api/event/EventBus.h>
 
 namespace ltps::tpr {
@@ -22,50 +27,98 @@ bool TprModule::init() {
     if (!mSafeTeleport) {
         mSafeTeleport = std::make_unique<SafeTeleport>(getServerThreadExecutor());
     }
+    if (!mDestinationPool) {
+        mDestinationPool = std::make_unique<DestinationPool>(*mSafeTeleport, getServerThreadExecutor());
+    }
     return true;
 }
 
 bool TprModule::enable() {
+    _reloadDangerousBlocks();
+    _reloadRegionCaches();
+
     auto& bus = ll::event::EventBus::getInstance();
 
     mListeners.emplace_back(bus.emplaceListener<PlayerRequestTprEvent>([this](PlayerRequestTprEvent& ev) {
-        auto& player = ev.getPlayer();
+        auto& player  = ev.getPlayer();
+        auto& session = TeleportSystem::getInstance().getSessionManager().getSession(player);
 
-        auto pos = getRandomPosWithConfig(player);
-        auto dim = player.getDimensionId();
+        if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(player)) {
+            limiter.sendRateLimitedMessage(player);
+            ev.cancel();
+            return;
+        }
+
+        auto dim       = player.getDimensionId();
+        auto pooled    = mDestinationPool->take(dim); // 优先使用预选目的地
+        auto coalesced = pooled ? std::nullopt : getCoalescedPos(player.getPosition(), dim, *mSafeTeleport);
+        auto random    = pooled ? pooled : coalesced;
+        if (!random) {
+            random = getRandomPosWithConfig(player.getPosition(), dim, *mSafeTeleport);
+        }
+        if (!random) {
+            mc_utils::sendText<mc_utils::Error>(
+                player,
+                "未找到可传送的随机位置，请联系管理员"_trl(session.getLocaleCode())
+            );
+            ev.cancel();
+            return;
+        }
+        auto pos = *random;
 
         auto& bus = ll::event::EventBus::getInstance();
 
         auto pre = PrepareCreateTprTaskEvent{player, pos, dim};
         bus.publish(pre);
 
+        auto&      coalescer = mSafeTeleport->getCoalescer();
+        auto const x         = static_cast<int>(pos.x);
+        auto const z         = static_cast<int>(pos.z);
         if (pre.isCancelled()) {
+            if (pooled) {
+                mDestinationPool->giveBack(dim, *pooled);
+            } else if (coalesced) {
+                coalescer.release(dim, x, z); // 归还分配的邻域名额
+            }
             ev.cancel();
             return;
         }
+        if (!pooled && !coalesced && getConfig().modules.tpr.coalesce.enable) {
+            coalescer.record(dim, x, z); // 后续请求可分配到此邻域，共享区块加载
+        }
 
-        mSafeTeleport->launchTask(player, {pos, dim});
+        auto charge = pre.getCharged();
+        if (pooled) {
+            mc_utils::sendText(player, "安全位置已找到，正在传送..."_trl(session.getLocaleCode()));
+            TeleportSystem::getInstance().getTeleportDispatcher().dispatch(
+                player,
+                dim,
+                [pos, dim](Player& self) { self.teleport(pos, dim); },
+                TeleportDispatcher::makeRefund(player, charge, mCooldown.getColumn())
+            );
+        } else {
+            mSafeTeleport->launchTask(player, {pos, dim}, charge, mCooldown.getColumn());
+        }
 
         bus.publish(TprTaskCreatedEvent{player, pos, dim});
     }));
 
     mListeners.emplace_back(bus.emplaceListener<PrepareCreateTprTaskEvent>([this](PrepareCreateTprTaskEvent& ev) {
-        auto& player = ev.getPlayer();
+        auto& player     = ev.getPlayer();
+        auto& session    = TeleportSystem::getInstance().getSessionManager().getSession(player);
+        auto& localeCode = session.getLocaleCode();
 
         if (getConfig().modules.tpr.disallowedDimensions.contains(player.getDimensionId())) {
-            mc_utils::sendText<mc_utils::Error>(player, "此功能在当前维度不可用"_trl(player.getLocaleCode()));
+            mc_utils::sendText<mc_utils::Error>(player, "此功能在当前维度不可用"_trl(localeCode));
             ev.cancel();
             return;
         }
 
         auto& cool = getCooldown();
-        if (cool.isCooldown(player.getRealName())) {
+        if (cool.isCooldown(session.getCooldownId())) {
             mc_utils::sendText<mc_utils::Error>(
                 player,
-                "TPR 冷却中，请稍后再试, 冷却时间: {0}"_trl(
-                    player.getLocaleCode(),
-                    cool.getCooldownString(player.getRealName())
-                )
+                "TPR 冷却中，请稍后再试, 冷却时间: {0}"_trl(localeCode, cool.getCooldownString(session.getCooldownId()))
             );
             ev.cancel();
             return;
@@ -79,19 +132,20 @@ bool TprModule::enable() {
                 "An exception occurred while calculating the TPA price, please check the configuration file.\n{}",
                 price.error()
             );
-            mc_utils::sendText<mc_utils::Error>(player, "Tpr 模块异常，请联系管理员"_trl(player.getLocaleCode()));
+            mc_utils::sendText<mc_utils::Error>(player, "Tpr 模块异常，请联系管理员"_trl(localeCode));
             ev.cancel();
             return;
         }
 
         auto& eco = EconomySystemManager::getInstance();
         if (!eco->reduce(player, price.value())) {
-            eco->sendNotEnoughMoneyMessage(player, price.value(), player.getLocaleCode());
+            eco->sendNotEnoughMoneyMessage(player, price.value(), localeCode);
             ev.cancel();
             return;
         }
+        ev.setCharged(static_cast<long long>(price.value()));
 
-        cool.setCooldown(player.getRealName(), getConfig().modules.tpr.cooldownTime);
+        cool.setCooldown(session.getCooldownId(), getConfig().modules.tpr.cooldownTime);
     }));
 
     TprCommand::setup();
@@ -100,6 +154,7 @@ bool TprModule::enable() {
 }
 
 bool TprModule::disable() {
+    mDestinationPool.reset();
     mSafeTeleport.reset();
 
     auto& bus = ll::event::EventBus::getInstance();
@@ -111,47 +166,142 @@ bool TprModule::disable() {
     return true;
 }
 
+void TprModule::onConfigReload() {
+    _reloadDangerousBlocks();
+    _reloadRegionCaches();
+    mDestinationPool->clear(); // 随机范围或危险方块可能已变更
+}
+
+void TprModule::_reloadDangerousBlocks() {
+    auto unknown = mSafeTeleport->resolveDangerousBlocks(getConfig().modules.tpr.dangerousBlocks);
+
+    auto& logger = TeleportSystem::getInstance().getSelf().getLogger();
+    for (auto const& name : unknown) {
+        logger.warn("Unknown dangerous block '{}' in tpr config, ignored", name);
+    }
+    logger.debug("Resolved {} dangerous block states", mSafeTeleport->getDangerousBlocks().size());
+}
+
+void TprModule::_reloadRegionCaches() {
+    auto const& cfg = getConfig().modules.tpr;
+    mSafeTeleport->getRejectedRegions().configure(
+        cfg.rejectedRegions.cellSize,
+        cfg.rejectedRegions.enable ? static_cast<std::size_t>(std::max(cfg.rejectedRegions.capacity, 0)) : 0,
+        std::chrono::seconds{cfg.rejectedRegions.ttlSeconds}
+    );
+    mSafeTeleport->getBiomeScreen().reset();
+    mSafeTeleport->getCoalescer().configure({
+        .radius             = std::max(cfg.coalesce.radius, 0),
+        .minDistance        = std::max(cfg.coalesce.minDistance, 0),
+        .maxPerNeighborhood = static_cast<std::size_t>(std::max(cfg.coalesce.maxPerNeighborhood, 0)),
+        .window             = std::chrono::seconds{cfg.coalesce.windowSeconds},
+    });
+}
+
 Cooldown& TprModule::getCooldown() { return mCooldown; }
 
-Vec3 TprModule::getRandomPosWithConfig(Player& player) {
+SafeTeleport* TprModule::getSafeTeleport() const { return mSafeTeleport.get(); }
+
+std::optional<Vec3> TprModule::getRandomPosWithConfig(Player& player) {
+    return getRandomPosWithConfig(player.getPosition());
+}
+
+AreaSampler::Area TprModule::getSampleArea(Vec3 const& playerPos) {
     auto const& cfg = getConfig().modules.tpr;
 
     if (!cfg.restrictedAreas.enable) {
-        auto& [min, max] = cfg.randomRange;
-        return {randomInt(min, max), 320, randomInt(min, max)};
+        auto [min, max] = cfg.randomRange;
+        if (min > max) std::swap(min, max);
+        return {.shape = AreaSampler::Shape::Range, .rangeMin = min, .rangeMax = max};
     }
 
     auto const& area = cfg.restrictedAreas;
 
-    auto& pos  = player.getPosition();
-    auto  cenx = area.center.usePlayerPositionCenter ? static_cast<int>(pos.x) : area.center.x;
-    auto  cenz = area.center.usePlayerPositionCenter ? static_cast<int>(pos.z) : area.center.z;
+    auto cenx = area.center.usePlayerPositionCenter ? static_cast<int>(playerPos.x) : area.center.x;
+    auto cenz = area.center.usePlayerPositionCenter ? static_cast<int>(playerPos.z) : area.center.z;
 
-    return randomCenterVec3(cenx, cenz, area.center.radius, area.isCircle);
+    return {
+        area.isCircle ? AreaSampler::Shape::Circle : AreaSampler::Shape::Square,
+        cenx,
+        cenz,
+        area.center.minRadius,
+        area.center.radius
+    };
 }
 
-Vec3 TprModule::randomCenterVec3(int centerX, int centerZ, int radius, bool isCircle) {
-    int minX = centerX - radius;
-    int maxX = centerX + radius;
-    int minZ = centerZ - radius;
-    int maxZ = centerZ + radius;
-    if (!isCircle) {
-        if (minX > maxX) std::swap(minX, maxX);
-        if (minZ > maxZ) std::swap(minZ, maxZ);
+std::vector<AreaSampler::ExclusionZone> TprModule::getExclusionZones() {
+    std::vector<AreaSampler::ExclusionZone> zones;
+    for (auto const& zone : getConfig().modules.tpr.exclusionZones) {
+        zones.push_back({zone.x, zone.z, zone.radius, zone.isCircle});
     }
-    return {randomInt(minX, maxX), 320, randomInt(minZ, maxZ)};
+    return zones;
 }
 
-int TprModule::randomInt(int min, int max) {
-    std::random_device rd;
+std::optional<Vec3> TprModule::getRandomPosWithConfig(Vec3 const& playerPos) {
+    auto sampled = AreaSampler::sample(getSampleArea(playerPos), getExclusionZones());
+    if (!sampled) {
+        return std::nullopt; // 范围几乎全部位于排除区域内
+    }
+    return Vec3{sampled->first, 320, sampled->second};
+}
 
-    auto seed_data = rd()
-                   ^ (std::hash<long long>()(std::chrono::high_resolution_clock::now().time_since_epoch().count())
-                      + std::chrono::high_resolution_clock::now().time_since_epoch().count());
-    std::mt19937_64                    mt(seed_data);
-    std::uniform_int_distribution<int> dist(min, max);
-    return dist(mt);
+std::optional<Vec3>
+TprModule::getRandomPosWithConfig(Vec3 const& playerPos, int dimId, SafeTeleport& safeTeleport) {
+    auto const& cfg = getConfig().modules.tpr;
+
+    auto const& regions  = cfg.rejectedRegions;
+    auto const& biomes   = cfg.biomeScreen;
+    auto const  attempts = 1
+                        + std::max(regions.enable ? regions.maxResamples : 0, biomes.enable ? biomes.maxResamples : 0);
+
+    std::optional<Vec3> last;
+    for (int i = 0; i < attempts; ++i) {
+        auto pos = getRandomPosWithConfig(playerPos);
+        if (!pos) {
+            break;
+        }
+        last = pos;
+
+        if (!passesScreens(dimId, static_cast<int>(pos->x), static_cast<int>(pos->z), safeTeleport)) {
+            continue;
+        }
+        return pos;
+    }
+    // 范围内大部分区域都被拒绝时不再继续重选，仍使用最后一次的随机点
+    return last;
+}
+
+bool TprModule::passesScreens(int dimId, int x, int z, SafeTeleport& safeTeleport) {
+    if (getConfig().modules.tpr.rejectedRegions.enable && safeTeleport.getRejectedRegions().isRejected(dimId, x, z)) {
+        return false;
+    }
+    return safeTeleport.getBiomeScreen().accepts(dimId, x, z);
+}
+
+std::optional<Vec3> TprModule::getCoalescedPos(Vec3 const& playerPos, int dimId, SafeTeleport& safeTeleport) {
+    auto const& cfg = getConfig().modules.tpr;
+    if (!cfg.coalesce.enable) {
+        return std::nullopt;
+    }
+    auto picked = safeTeleport.getCoalescer().pick(
+        dimId,
+        getSampleArea(playerPos),
+        getExclusionZones(),
+        [dimId, &safeTeleport](int x, int z) { return passesScreens(dimId, x, z, safeTeleport); }
+    );
+    if (!picked) {
+        return std::nullopt;
+    }
+    return Vec3{picked->first, 320, picked->second};
+}
+
+Vec3 TprModule::randomCenterVec3(int centerX, int centerZ, int radius, bool isCircle) {
+    auto [x, z] = AreaSampler::sample(
+        {isCircle ? AreaSampler::Shape::Circle : AreaSampler::Shape::Square, centerX, centerZ, 0, std::abs(radius)}
+    );
+    return {x, 320, z};
 }
 
+int TprModule::randomInt(int min, int max) { return AreaSampler::randomInt(min, max); }
 
 } // namespace ltps::tpr
\ No newline at end of file
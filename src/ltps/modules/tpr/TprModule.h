@@ -1,17 +1,24 @@
 #pragma once
+#include "AreaSampler.h"
+#include "DestinationPool.h"
 #include "SafeTeleport.h"
 #include "ltps/common/Cooldown.h"
 #include "ltps/modules/IModule.h"
 #include <ll/api/event/Event.h>
 #include <ll/api/event/ListenerBase.h>
+#include <optional>
 
 namespace ltps::tpr {
 
 class TprModule final : public IModule {
-    Cooldown                            mCooldown;
+    Cooldown                            mCooldown{CooldownTable::Column::Tpr};
     std::unique_ptr<SafeTeleport>       mSafeTeleport;
+    std::unique_ptr<DestinationPool>    mDestinationPool;
     std::vector<ll::event::ListenerPtr> mListeners;
 
+    void _reloadDangerousBlocks();
+    void _reloadRegionCaches();
+
 public:
     TPS_DISALLOW_COPY(TprModule);
 
@@ -30,9 +37,28 @@ class TprModule final : public IModule {
 
     TPSNDAPI bool disable() override;
 
+    TPSAPI void onConfigReload() override;
+
     TPSNDAPI Cooldown& getCooldown();
 
-    TPSAPI static Vec3 getRandomPosWithConfig(Player& player); // 基于 Config 配置生成随机坐标
+    TPSNDAPI SafeTeleport* getSafeTeleport() const;
+
+    TPSNDAPI static AreaSampler::Area getSampleArea(Vec3 const& playerPos); // 配置的随机区域
+
+    TPSNDAPI static std::vector<AreaSampler::ExclusionZone> getExclusionZones(); // 配置的排除区域
+
+    // 基于 Config 配置生成随机坐标，跳过排除区域，采样均被排除时返回 nullopt
+    TPSAPI static std::optional<Vec3> getRandomPosWithConfig(Player& player);
+    TPSAPI static std::optional<Vec3> getRandomPosWithConfig(Vec3 const& playerPos);
+    // 跳过已拒绝的区域与群系预筛选拒绝的点，重新选点次数见 rejectedRegions / biomeScreen.maxResamples
+    TPSAPI static std::optional<Vec3>
+    getRandomPosWithConfig(Vec3 const& playerPos, int dimId, SafeTeleport& safeTeleport);
+
+    // 不在已拒绝的区域内且通过群系预筛选
+    TPSNDAPI static bool passesScreens(int dimId, int x, int z, SafeTeleport& safeTeleport);
+
+    // 在最近选中的区块邻域内分配坐标（tpr.coalesce），同样经过上述筛选，没有可用邻域时返回 nullopt
+    TPSAPI static std::optional<Vec3> getCoalescedPos(Vec3 const& playerPos, int dimId, SafeTeleport& safeTeleport);
     TPSAPI static int  randomInt(int min, int max);
     TPSAPI static Vec3 randomCenterVec3(int centerX, int centerZ, int radius, bool isCircle = true);
 };
@@ -18,6 +18,8 @@ int         ITprTaskEvent::getTargetDimensionId() const { return mTargetDimensio
 
 PrepareCreateTprTaskEvent::PrepareCreateTprTaskEvent(Player& player, Vec3 targetPosition, int targetDimensionId)
 : ITprTaskEvent(player, targetPosition, targetDimensionId) {}
+void      PrepareCreateTprTaskEvent::setCharged(long long charged) { mCharged = charged; }
+long long PrepareCreateTprTaskEvent::getCharged() const { return mCharged; }
 TprTaskCreatedEvent::TprTaskCreatedEvent(Player& player, Vec3 targetPosition, int targetDimensionId)
 : ITprTaskEvent(player, targetPosition, targetDimensionId) {}
 
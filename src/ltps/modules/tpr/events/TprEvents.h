@@ -37,8 +37,13 @@ class ITprTaskEvent {
  * @brief 准备创建随机传送任务
  */
 class PrepareCreateTprTaskEvent final : public Cancellable<Event>, public ITprTaskEvent {
+    long long mCharged{0}; // 监听者扣除的费用，传送被分发队列丢弃时退还
+
 public:
     TPSAPI explicit PrepareCreateTprTaskEvent(Player& player, Vec3 targetPosition, int targetDimensionId);
+
+    TPSAPI void        setCharged(long long charged);
+    TPSNDAPI long long getCharged() const;
 };
 
 /**
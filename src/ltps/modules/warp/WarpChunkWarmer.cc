@@ -0,0 +1,146 @@
+#include "WarpChunkWarmer.h"
+#include "WarpStorage.h"
+#include "ll/api/chrono/GameChrono.h"
+#include "ll/api/service/Bedrock.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
+#include <algorithm>
+#include <cstdlib>
+#include <ll/api/coro/CoroTask.h>
+#include <mc/deps/core/math/Vec3.h>
+#include <mc/deps/game_refs/WeakRef.h>
+#include <mc/world/level/BlockPos.h>
+#include <mc/world/level/ChunkPos.h>
+#include <mc/world/level/Level.h>
+#include <mc/world/level/chunk/ChunkSource.h>
+#include <mc/world/level/chunk/ChunkState.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <mc/world/level/dimension/Dimension.h>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace ltps::warp {
+
+
+namespace {
+
+// 区块已加载到可读取方块（与 tpr::ChunkLoadWatcher::isChunkReady 一致）
+bool isChunkReady(LevelChunk const& chunk) {
+    return static_cast<int>(chunk.mLoadState->load()) >= static_cast<int>(ChunkState::Loaded)
+        && !chunk.mIsEmptyClientChunk;
+}
+
+} // namespace
+
+
+WarpChunkWarmer::WarpChunkWarmer(WarpStorage& storage, ll::thread::ServerThreadExecutor const& executor)
+: mStorage(storage) {
+    mInterruptableSleep = std::make_shared<ll::coro::InterruptableSleep>();
+    mAbortFlag          = std::make_shared<std::atomic_bool>(false);
+
+    ll::coro::keepThis([this, sleep = mInterruptableSleep, abortFlag = mAbortFlag]() -> ll::coro::CoroTask<> {
+        while (!abortFlag->load()) {
+            try {
+                refresh();
+            } catch (...) {
+                TeleportSystem::getInstance().getSelf().getLogger().error(
+                    "An exception occurred while warming warp chunks"
+                );
+            }
+            auto interval = std::max(getConfig().modules.warp.preload.refreshSeconds, 1);
+            co_await sleep->sleepFor(ll::chrono::ticks{interval * 20});
+        }
+        co_return;
+    }).launch(executor.getDefault());
+}
+
+WarpChunkWarmer::~WarpChunkWarmer() {
+    mAbortFlag->store(true);
+    mInterruptableSleep->interrupt(true);
+    mPinned.clear();
+}
+
+void WarpChunkWarmer::refresh() {
+    auto level = ll::service::getLevel();
+    if (!level) {
+        return; // 世界尚未加载，下次再试
+    }
+
+    auto const& cfg       = getConfig().modules.warp.preload;
+    auto const  radius    = std::max(cfg.chunkRadius, 0);
+    auto const  maxChunks = static_cast<std::size_t>(std::max(cfg.maxChunks, 0));
+
+    // 配置的传送点优先，其次按使用热度
+    std::vector<WarpStorage::Warp> targets;
+    std::set<std::string>          chosen;
+    for (auto const& name : cfg.warps) {
+        if (auto warp = mStorage.getWarp(name); warp && chosen.insert(name).second) {
+            targets.push_back(std::move(*warp));
+        }
+    }
+    int topUsed = std::max(cfg.topUsed, 0);
+    for (auto const& warp : mStorage.getRankedWarps()) {
+        if (topUsed <= 0) {
+            break;
+        }
+        if (mStorage.getScore(warp.name) <= 0.0 || !chosen.insert(warp.name).second) {
+            continue;
+        }
+        targets.push_back(warp);
+        topUsed--;
+    }
+
+    std::map<ChunkKey, std::shared_ptr<LevelChunk>> pinned;
+    for (auto const& warp : targets) {
+        auto dimension = level->getDimension(warp.dimid).lock();
+        if (!dimension) {
+            continue;
+        }
+        auto& chunkSource = dimension->getChunkSource();
+        auto  center      = ChunkPos{BlockPos{Vec3{warp.x, warp.y, warp.z}}};
+
+        // 由内向外，区块数达到上限时优先保留传送点所在区块
+        for (int r = 0; r <= radius; ++r) {
+            for (int dx = -r; dx <= r; ++dx) {
+                for (int dz = -r; dz <= r; ++dz) {
+                    if (std::max(std::abs(dx), std::abs(dz)) != r || pinned.size() >= maxChunks) {
+                        continue;
+                    }
+                    auto pos = ChunkPos{center.x + dx, center.z + dz};
+                    auto key = ChunkKey{warp.dimid, pos.x, pos.z};
+                    if (pinned.contains(key) || !chunkSource.isWithinWorldLimit(pos)) {
+                        continue;
+                    }
+                    if (auto iter = mPinned.find(key); iter != mPinned.end()) {
+                        pinned.emplace(key, std::move(iter->second));
+                        continue;
+                    }
+                    if (auto chunk = chunkSource.getOrLoadChunk(pos, ::ChunkSource::LoadMode::Deferred, false)) {
+                        pinned.emplace(key, std::move(chunk));
+                    }
+                }
+            }
+        }
+    }
+    mPinned = std::move(pinned); // 不再需要的区块在此释放引用
+
+    TeleportSystem::getInstance().getSelf().getLogger().debug(
+        "[WarpChunkWarmer]: {} of {} pinned chunks ready",
+        readyCount(),
+        mPinned.size()
+    );
+}
+
+std::size_t WarpChunkWarmer::size() const { return mPinned.size(); }
+
+std::size_t WarpChunkWarmer::readyCount() const {
+    return std::count_if(mPinned.begin(), mPinned.end(), [](auto const& entry) {
+        return entry.second && isChunkReady(*entry.second);
+    });
+}
+
+
+} // namespace ltps::warp
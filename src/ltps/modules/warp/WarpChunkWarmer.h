@@ -0,0 +1,50 @@
+#pragma once
+#include "ltps/Global.h"
+#include <atomic>
+#include <cstddef>
+#include <ll/api/coro/InterruptableSleep.h>
+#include <ll/api/thread/ServerThreadExecutor.h>
+#include <map>
+#include <memory>
+#include <tuple>
+
+
+class LevelChunk;
+
+namespace ltps::warp {
+
+
+class WarpStorage;
+
+/**
+ * @brief 传送点目的地区块预热
+ * 持有配置的传送点与使用热度最高的传送点周围的区块引用，使其常驻内存，
+ * 玩家到达时不再等待区块从存档加载 / 生成。持有的区块数受 maxChunks 限制（按区块个数计，不是内存大小），
+ * 定期按热度重新选择。区块以 Deferred 模式请求，持有后不一定已加载完成，统计时只计入已就绪的区块。
+ */
+class WarpChunkWarmer final {
+    using ChunkKey = std::tuple<int, int, int>; // 维度, 区块 X, 区块 Z
+
+    WarpStorage&                                    mStorage;
+    std::map<ChunkKey, std::shared_ptr<LevelChunk>> mPinned; // 持有的区块，释放引用后由区块源回收
+    std::shared_ptr<ll::coro::InterruptableSleep>   mInterruptableSleep{nullptr};
+    std::shared_ptr<std::atomic_bool>               mAbortFlag{nullptr};
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(WarpChunkWarmer);
+
+    TPSAPI explicit WarpChunkWarmer(WarpStorage& storage, ll::thread::ServerThreadExecutor const& executor);
+    TPSAPI ~WarpChunkWarmer();
+
+    // 重新选择预热的区块（加载新增的，释放不再需要的）
+    TPSAPI void refresh();
+
+    // 当前持有的区块数（含尚未加载完成的）
+    TPSNDAPI std::size_t size() const;
+
+    // 已加载完成、可直接使用的区块数
+    TPSNDAPI std::size_t readyCount() const;
+};
+
+
+} // namespace ltps::warp
@@ -5,9 +5,11 @@
 #include "gui/WarpGUI.h"
 #include "ll/api/event/EventBus.h"
 #include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
 #include "ltps/database/PermissionStorage.h"
 #include "ltps/modules/warp/gui/WarpOperatorGUI.h"
 #include "ltps/utils/McUtils.h"
+#include <algorithm>
 #include <ll/api/command/CommandHandle.h>
 #include <mc/world/level/dimension/VanillaDimensions.h>
 
@@ -18,6 +20,14 @@ struct WarpListParam {
     std::string name;
 };
 
+struct WarpTagParam {
+    std::string tag;
+};
+
+struct WarpNearParam {
+    int count{0};
+};
+
 struct WarpActionParam {
     enum class Action { Add, Remove, Go };
     Action      action;
@@ -51,10 +61,12 @@ void WarpCommand::setup() {
             auto  storage    = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
 
             if (param.name.empty()) {
-                auto        warps = storage->getWarps(16);
-                std::string text  = "当前服务器共有 {} 个公共传送点:"_trl(localeCode, warps.size());
-                for (const auto& warp : warps) {
-                    text += fmt::format(" ,{}", warp.name);
+                auto const& warps = getConfig().modules.warp.usage.rankMenus ? storage->getRankedWarps()
+                                                                             : storage->getWarps();
+                auto        count = std::min<std::size_t>(warps.size(), 16);
+                std::string text  = "当前服务器共有 {} 个公共传送点:"_trl(localeCode, count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    text += fmt::format(" ,{}", warps[i].name);
                 }
                 mc_utils::sendText<mc_utils::Info>(output, text);
                 return;
@@ -62,13 +74,23 @@ void WarpCommand::setup() {
 
             auto warp = storage->getWarp(param.name);
             if (!warp) {
-                mc_utils::sendText<mc_utils::Error>(output, "未找到该公共传送点"_trl(localeCode));
+                auto matches = storage->queryWarp(param.name, 16);
+                if (matches.empty()) {
+                    mc_utils::sendText<mc_utils::Error>(output, "未找到该公共传送点"_trl(localeCode));
+                    return;
+                }
+                std::string text = "找到 {} 个相似的公共传送点:"_trl(localeCode, matches.size());
+                for (const auto& match : matches) {
+                    text += fmt::format(" ,{}", match.name);
+                }
+                mc_utils::sendText<mc_utils::Info>(output, text);
                 return;
             }
 
+            auto usage = storage->getUsage(warp->name).value_or(WarpStorage::Usage{});
             mc_utils::sendText(
                 output,
-                "名称: {} 坐标：{},{},{} 维度: {} 创建时间: {} 修改时间: {}"_trl(
+                "名称: {} 坐标：{},{},{} 维度: {} 创建时间: {} 修改时间: {} 使用次数: {} 热度: {:.2f}"_trl(
                     localeCode,
                     warp->name,
                     warp->x,
@@ -76,12 +98,80 @@ void WarpCommand::setup() {
                     warp->z,
                     VanillaDimensions::toString(warp->dimid),
                     warp->createdTime,
-                    warp->modifiedTime
+                    warp->modifiedTime,
+                    usage.total,
+                    storage->getScore(warp->name)
                 )
             );
         }
     );
 
+    // warp tag [tag]
+    cmd.overload<WarpTagParam>().text("tag").optional("tag").execute(
+        [](CommandOrigin const& origin, CommandOutput& output, WarpTagParam const& param) {
+            if (origin.getOriginType() != CommandOriginType::Player) {
+                mc_utils::sendText<mc_utils::Error>(output, "此命令只能由玩家执行"_tr());
+                return;
+            }
+
+            auto& player     = *static_cast<Player*>(origin.getEntity());
+            auto  localeCode = TeleportSystem::getInstance().getSessionManager().getSession(player).getLocaleCode();
+            auto  storage    = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
+
+            if (param.tag.empty()) {
+                auto const& index = storage->getTagIndex();
+                if (index.empty()) {
+                    mc_utils::sendText<mc_utils::Error>(output, "当前没有任何传送点分类"_trl(localeCode));
+                    return;
+                }
+                std::string text = "当前共有 {} 个传送点分类:"_trl(localeCode, index.size());
+                for (auto const& [tag, names] : index) {
+                    text += fmt::format(" ,{}({})", tag, names.size());
+                }
+                mc_utils::sendText<mc_utils::Info>(output, text);
+                return;
+            }
+
+            auto warps = storage->getWarpsByTag(param.tag);
+            if (warps.empty()) {
+                mc_utils::sendText<mc_utils::Error>(output, "未找到该分类"_trl(localeCode));
+                return;
+            }
+            std::string text = "分类 {} 中共有 {} 个公共传送点:"_trl(localeCode, param.tag, warps.size());
+            for (auto const& warp : warps) {
+                text += fmt::format(" ,{}", warp.name);
+            }
+            mc_utils::sendText<mc_utils::Info>(output, text);
+        }
+    );
+
+    // warp near [count]
+    cmd.overload<WarpNearParam>().text("near").optional("count").execute(
+        [](CommandOrigin const& origin, CommandOutput& output, WarpNearParam const& param) {
+            if (origin.getOriginType() != CommandOriginType::Player) {
+                mc_utils::sendText<mc_utils::Error>(output, "此命令只能由玩家执行"_tr());
+                return;
+            }
+
+            auto& player     = *static_cast<Player*>(origin.getEntity());
+            auto  localeCode = TeleportSystem::getInstance().getSessionManager().getSession(player).getLocaleCode();
+            auto  storage    = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
+
+            auto count   = static_cast<std::size_t>(std::clamp(param.count > 0 ? param.count : 5, 1, 16));
+            auto nearest = storage->getNearestWarps(player.getDimensionId(), player.getPosition(), count);
+            if (nearest.empty()) {
+                mc_utils::sendText<mc_utils::Error>(output, "当前维度没有公共传送点"_trl(localeCode));
+                return;
+            }
+
+            std::string text = "距离最近的 {} 个公共传送点:"_trl(localeCode, nearest.size());
+            for (auto const& [warp, distance] : nearest) {
+                text += fmt::format(" ,{}({:.0f}m)", warp.name, distance);
+            }
+            mc_utils::sendText<mc_utils::Info>(output, text);
+        }
+    );
+
     // warp <add|remove|go> <name>
     cmd.overload<WarpActionParam>().required("action").required("name").execute(
         [](CommandOrigin const& origin, CommandOutput& output, WarpActionParam const& param) {
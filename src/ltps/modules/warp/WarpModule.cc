@@ -4,7 +4,9 @@
 #include "event/WarpEvents.h"
 #include "ltps/TeleportSystem.h"
 #include "ltps/base/Config.h"
+#include "ltps/common/FormCache.h"
 #include "ltps/common/PriceCalculate.h"
+#include "ltps/common/RateLimiter.h"
 #include "ltps/database/PermissionStorage.h"
 #include "ltps/database/StorageManager.h"
 #include "ltps/utils/McUtils.h"
@@ -34,6 +36,12 @@ bool WarpModule::enable() {
             auto  localeCode = player.getLocaleCode();
             auto& name       = ev.getName();
 
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(realName)) {
+                limiter.sendRateLimitedMessage(player, localeCode);
+                ev.cancel();
+                return;
+            }
+
             auto storage = getStorage();
             if (!storage) {
                 throw std::runtime_error("WarpStorage not found");
@@ -54,11 +62,18 @@ bool WarpModule::enable() {
                 return;
             }
 
-            warp->teleport(player);
+            TeleportSystem::getInstance().getTeleportDispatcher().dispatch(
+                player,
+                warp->dimid,
+                [warp = *warp](Player& self) {
+                    warp.teleport(self);
 
-            auto teleported = WarpTeleportedEvent(player, warp.value());
+                    auto teleported = WarpTeleportedEvent(self, warp);
 
-            bus.publish(teleported);
+                    ll::event::EventBus::getInstance().publish(teleported);
+                },
+                TeleportDispatcher::makeRefund(player, teleporting.getCharged(), mCooldown.getColumn())
+            );
             ev.invokeCallback(warp.value());
         },
         ll::event::EventPriority::High
@@ -66,15 +81,17 @@ bool WarpModule::enable() {
     mListeners.emplace_back(bus.emplaceListener<WarpTeleportingEvent>(
         [this](WarpTeleportingEvent& ev) {
             auto& player     = ev.getPlayer();
-            auto  realName   = player.getRealName();
-            auto  localeCode = player.getLocaleCode();
+            auto& session    = TeleportSystem::getInstance().getSessionManager().getSession(player);
+            auto& realName   = session.getRealName();
+            auto& localeCode = session.getLocaleCode();
 
-            auto& cooldown = getCooldown();
+            auto& cooldown   = getCooldown();
+            auto  cooldownId = session.getCooldownId();
 
-            if (cooldown.isCooldown(realName)) {
+            if (cooldown.isCooldown(cooldownId)) {
                 mc_utils::sendText(
                     player,
-                    "传送冷却中, 请稍后重试，冷却时间: {}"_trl(localeCode, cooldown.getCooldownString(realName))
+                    "传送冷却中, 请稍后重试，冷却时间: {}"_trl(localeCode, cooldown.getCooldownString(cooldownId))
                 );
                 ev.cancel();
                 return;
@@ -102,12 +119,19 @@ bool WarpModule::enable() {
                 ev.cancel();
                 return;
             }
+            ev.setCharged(static_cast<llong>(price.value()));
 
-            cooldown.setCooldown(realName, getConfig().modules.warp.cooldownTime);
+            cooldown.setCooldown(cooldownId, getConfig().modules.warp.cooldownTime);
         },
         ll::event::EventPriority::High
     ));
 
+    mListeners.emplace_back(bus.emplaceListener<WarpTeleportedEvent>([this](WarpTeleportedEvent& ev) {
+        if (auto storage = getStorage()) {
+            storage->recordUse(ev.getWarp().name);
+        }
+    }));
+
     mListeners.emplace_back(bus.emplaceListener<PlayerRequestAddWarpEvent>(
         [this](PlayerRequestAddWarpEvent& ev) {
             auto&           player     = ev.getPlayer();
@@ -158,9 +182,9 @@ bool WarpModule::enable() {
                 throw std::runtime_error("WarpStorage not found");
             }
 
-            auto&           player     = ev.getPlayer();
-            auto            localeCode = player.getLocaleCode();
-            RealName const& realName   = player.getRealName();
+            auto& player     = ev.getPlayer();
+            auto& session    = TeleportSystem::getInstance().getSessionManager().getSession(player);
+            auto& localeCode = session.getLocaleCode();
 
             auto const& dimid = ev.getWarp().dimid;
             if (getConfig().modules.warp.disallowedDimensions.contains(dimid)) {
@@ -169,8 +193,8 @@ bool WarpModule::enable() {
                 return;
             }
 
-            auto pe = getStorageManager().getStorage<PermissionStorage>();
-            if (pe && !pe->hasPermission(realName, PermissionStorage::Permission::AddWarp)) {
+            // 没有 PermissionStorage 时不限制
+            if (!session.hasPermission(PermissionStorage::Permission::AddWarp, true)) {
                 mc_utils::sendText<mc_utils::Error>(player, "你没有权限创建公共传送点"_trl(localeCode));
                 ev.cancel();
                 return;
@@ -230,12 +254,12 @@ bool WarpModule::enable() {
     ));
     mListeners.emplace_back(bus.emplaceListener<WarpRemovingEvent>(
         [this](WarpRemovingEvent& ev) {
-            auto&           player     = ev.getPlayer();
-            auto            localeCode = player.getLocaleCode();
-            RealName const& realName   = player.getRealName();
+            auto& player     = ev.getPlayer();
+            auto& session    = TeleportSystem::getInstance().getSessionManager().getSession(player);
+            auto& localeCode = session.getLocaleCode();
 
-            auto pe = getStorageManager().getStorage<PermissionStorage>();
-            if (pe && !pe->hasPermission(realName, PermissionStorage::Permission::RemoveWarp)) {
+            // 没有 PermissionStorage 时不限制
+            if (!session.hasPermission(PermissionStorage::Permission::RemoveWarp, true)) {
                 mc_utils::sendText<mc_utils::Error>(player, "你没有权限删除公共传送点"_trl(localeCode));
                 ev.cancel();
                 return;
@@ -259,10 +283,16 @@ bool WarpModule::enable() {
                 return;
             }
 
-            warp.teleport(player);
+            TeleportSystem::getInstance().getTeleportDispatcher().dispatch(
+                player,
+                warp.dimid,
+                [warp](Player& self) {
+                    warp.teleport(self);
 
-            auto ed = AdminTeleportedWarpEvent{player, warp};
-            bus.publish(ed);
+                    auto ed = AdminTeleportedWarpEvent{self, warp};
+                    ll::event::EventBus::getInstance().publish(ed);
+                }
+            );
         },
         ll::event::EventPriority::High
     ));
@@ -276,14 +306,14 @@ bool WarpModule::enable() {
             auto& pos        = ev.getPosition();
             auto  dimid      = ev.getDimid();
 
-            auto ing = AdminCreateingWarpEvent{player, name, dimid, pos};
+            auto ing = AdminCreateingWarpEvent{player, name, dimid, pos, ev.getTags()};
             bus.publish(ing);
 
             if (ing.isCancelled()) {
                 return;
             }
 
-            auto warp = WarpStorage::Warp::make(pos, dimid, name);
+            auto warp = WarpStorage::Warp::make(pos, dimid, name, ev.getTags());
 
             auto storage = this->getStorage();
             if (auto res = storage->addWarp(warp)) {
@@ -382,6 +412,7 @@ bool WarpModule::enable() {
 
 
     WarpCommand::setup();
+    _updateChunkWarmer();
     return true;
 }
 
@@ -391,10 +422,30 @@ bool WarpModule::disable() {
         bus.removeListener(p);
     }
     mListeners.clear();
+    mChunkWarmer.reset();
+    FormCache::getInstance().invalidate("warp.");
 
     return true;
 }
 
+void WarpModule::onConfigReload() { _updateChunkWarmer(); }
+
+void WarpModule::_updateChunkWarmer() {
+    if (!getConfig().modules.warp.preload.enable) {
+        mChunkWarmer.reset();
+        return;
+    }
+    if (mChunkWarmer) {
+        mChunkWarmer->refresh();
+        return;
+    }
+    if (auto storage = getStorage()) {
+        mChunkWarmer = std::make_unique<WarpChunkWarmer>(*storage, getServerThreadExecutor());
+    }
+}
+
+WarpChunkWarmer* WarpModule::getChunkWarmer() const { return mChunkWarmer.get(); }
+
 WarpStorage* WarpModule::getStorage() const { return getStorageManager().getStorage<WarpStorage>(); }
 
 Cooldown& WarpModule::getCooldown() { return mCooldown; }
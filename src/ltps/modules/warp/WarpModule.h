@@ -1,16 +1,21 @@
 #pragma once
+#include "WarpChunkWarmer.h"
 #include "WarpStorage.h"
 #include "ltps/common/Cooldown.h"
 #include "ltps/modules/IModule.h"
 #include <ll/api/event/ListenerBase.h>
 #include <ll/api/event/entity/ActorEvent.h>
+#include <memory>
 
 namespace ltps::warp {
 
 
 class WarpModule final : public IModule {
-    Cooldown                            mCooldown;
+    Cooldown                            mCooldown{CooldownTable::Column::Warp};
     std::vector<ll::event::ListenerPtr> mListeners;
+    std::unique_ptr<WarpChunkWarmer>    mChunkWarmer; // 未启用预热时为空
+
+    void _updateChunkWarmer();
 
 public:
     TPS_DISALLOW_COPY(WarpModule);
@@ -30,9 +35,13 @@ class WarpModule final : public IModule {
 
     TPSAPI bool disable() override;
 
+    TPSAPI void onConfigReload() override;
+
     TPSNDAPI WarpStorage* getStorage() const;
 
     TPSNDAPI Cooldown& getCooldown();
+
+    TPSNDAPI WarpChunkWarmer* getChunkWarmer() const;
 };
 
 
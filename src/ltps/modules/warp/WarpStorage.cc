@@ -1,5 +1,7 @@
 #include "WarpStorage.h"
 #include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
+#include "ltps/common/FormCache.h"
 #include "ltps/utils/JsonUtls.h"
 #include "ltps/utils/McUtils.h"
 #include "ltps/utils/TimeUtils.h"
@@ -7,9 +9,30 @@
 #include "mc/world/actor/player/Player.h"
 #include "mc/world/level/dimension/VanillaDimensions.h"
 #include "nlohmann/json.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
 
 namespace ltps::warp {
 
+
+namespace {
+
+std::int64_t nowSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+double decayedScore(WarpStorage::Usage const& usage, std::int64_t now) {
+    auto halfLife = std::max(getConfig().modules.warp.usage.halfLifeDays, 0.01) * 86400.0;
+    auto elapsed  = static_cast<double>(std::max<std::int64_t>(now - usage.updatedAt, 0));
+    return usage.score * std::exp2(-elapsed / halfLife);
+}
+
+} // namespace
+
+
 WarpStorage::WarpStorage() = default;
 
 void WarpStorage::load() {
@@ -33,8 +56,11 @@ void WarpStorage::load() {
         for (auto& [key, value] : json.items()) {
             Warp warp;
             json_utils::json2structTryPatch(warp, value);
+            warp.tags = normalizeTags(std::move(warp.tags));
             mWarps.push_back(std::move(warp));
         }
+        _rebuildIndexes();
+        _loadUsage();
         TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} warps", mWarps.size());
     } catch (const nlohmann::json::parse_error& e) {
         throw std::runtime_error("Could not parse warp data");
@@ -47,46 +73,140 @@ void WarpStorage::writeBack() {
     auto& db   = getDatabase();
     auto  json = json_utils::struct2json(mWarps);
     db.set(STORAGE_KEY, json.dump());
+    db.set(USAGE_KEY, json_utils::struct2json(mUsage).dump());
+}
+
+void WarpStorage::_loadUsage() {
+    auto& db = getDatabase();
+
+    mUsage.clear();
+    auto rawJson = db.get(USAGE_KEY);
+    if (!rawJson) {
+        return;
+    }
+    try {
+        auto json = nlohmann::json::parse(rawJson.value());
+        json_utils::json2struct(mUsage, json);
+    } catch (...) {
+        // 统计数据损坏不影响传送点，丢弃后重新统计
+        mUsage.clear();
+        TeleportSystem::getInstance().getSelf().getLogger().warn("Could not parse warp usage data, reset");
+    }
+    std::erase_if(mUsage, [this](auto const& pair) { return !hasWarp(pair.first); });
+}
+
+void WarpStorage::_rebuildIndexes() {
+    mPositions.clear();
+    mNameIndex.clear();
+    mSpatialIndex.clear();
+    mTagIndex.clear();
+    mVersion++;
+    FormCache::getInstance().invalidate("warp.");
+    for (std::size_t i = 0; i < mWarps.size(); ++i) {
+        mPositions[mWarps[i].name] = i;
+        mNameIndex.insert(mWarps[i].name);
+        _indexPosition(mWarps[i]);
+        _indexTags(mWarps[i]);
+    }
+}
+
+void WarpStorage::_indexPosition(Warp const& warp) {
+    mSpatialIndex.insert(warp.name, {warp.dimid, warp.x, warp.y, warp.z});
 }
 
-bool WarpStorage::hasWarp(std::string const& name) const {
-    auto it = std::find_if(mWarps.begin(), mWarps.end(), [&](Warp const& warp) { return name == warp.name; });
-    return it != mWarps.end();
+void WarpStorage::_indexTags(Warp const& warp) {
+    for (auto const& tag : warp.tags) {
+        mTagIndex[tag].insert(warp.name);
+    }
+}
+
+void WarpStorage::_unindexTags(Warp const& warp) {
+    for (auto const& tag : warp.tags) {
+        auto iter = mTagIndex.find(tag);
+        if (iter == mTagIndex.end()) {
+            continue;
+        }
+        iter->second.erase(warp.name);
+        if (iter->second.empty()) {
+            mTagIndex.erase(iter);
+            FormCache::getInstance().invalidate("warp."); // 标签已删除，其表单不会再被查找
+        }
+    }
 }
 
+bool WarpStorage::hasWarp(std::string const& name) const { return mPositions.contains(name); }
+
 Result<void> WarpStorage::addWarp(Warp warp) {
     if (hasWarp(warp.name)) {
         return std::unexpected("Warp name repeated");
     }
+    warp.tags             = normalizeTags(std::move(warp.tags));
+    mPositions[warp.name] = mWarps.size();
+    mNameIndex.insert(warp.name);
+    _indexPosition(warp);
+    _indexTags(warp);
     mWarps.emplace_back(warp);
+    mVersion++;
     return {};
 }
 
 Result<void> WarpStorage::updateWarp(std::string const& name, Warp warp) {
-    auto it = std::find_if(mWarps.begin(), mWarps.end(), [&](Warp const& warp) { return warp.name == name; });
-    if (it == mWarps.end()) {
+    auto iter = mPositions.find(name);
+    if (iter == mPositions.end()) {
         return std::unexpected("Warp not found");
     }
-    it->updateModifiedTime();
-    *it = std::move(warp);
+    if (warp.name != name && hasWarp(warp.name)) {
+        return std::unexpected("Warp name repeated");
+    }
+    auto index = iter->second;
+    warp.tags  = normalizeTags(std::move(warp.tags));
+    _unindexTags(mWarps[index]);
+    if (warp.name != name) { // 重命名
+        mPositions.erase(iter);
+        mPositions[warp.name] = index;
+        mNameIndex.erase(name);
+        mNameIndex.insert(warp.name);
+        mSpatialIndex.erase(name);
+        if (auto usage = mUsage.extract(name)) {
+            usage.key() = warp.name;
+            mUsage.insert(std::move(usage));
+        }
+    }
+    _indexPosition(warp);
+    _indexTags(warp);
+    mWarps[index].updateModifiedTime();
+    mWarps[index] = std::move(warp);
+    mVersion++;
     return {};
 }
 
 Result<void> WarpStorage::removeWarp(std::string const& name) {
-    auto it = std::find_if(mWarps.begin(), mWarps.end(), [&](Warp const& warp) { return warp.name == name; });
-    if (it == mWarps.end()) {
+    auto iter = mPositions.find(name);
+    if (iter == mPositions.end()) {
         return std::unexpected("Warp not found");
     }
-    mWarps.erase(it);
+    auto index = iter->second;
+    _unindexTags(mWarps[index]);
+    mWarps.erase(mWarps.begin() + static_cast<std::ptrdiff_t>(index));
+    mPositions.erase(iter);
+    mNameIndex.erase(name);
+    mSpatialIndex.erase(name);
+    mUsage.erase(name);
+    mVersion++;
+    for (auto& [_, position] : mPositions) { // 保持列表顺序，后续下标前移
+        if (position > index) {
+            --position;
+        }
+    }
     return {};
 }
 
 std::optional<WarpStorage::Warp> WarpStorage::getWarp(std::string const& name) const {
-    auto it = std::find_if(mWarps.begin(), mWarps.end(), [&](Warp const& warp) { return warp.name == name; });
-    if (it == mWarps.end()) {
+    auto iter = mPositions.find(name);
+    if (iter == mPositions.end()) {
         return std::nullopt;
     }
-    return *it;
+    return mWarps[iter->second];
 }
 
 WarpStorage::Warps const& WarpStorage::getWarps() const { return mWarps; }
@@ -107,19 +227,166 @@ std::vector<WarpStorage::Warp> WarpStorage::getWarps(int count) const {
 }
 
 
-WarpStorage::Warps WarpStorage::queryWarp(std::string const& keyword) const {
+WarpStorage::Warps WarpStorage::queryWarp(std::string const& keyword, std::size_t limit) const {
+    Warps result;
+    for (auto const& name : mNameIndex.search(keyword, limit)) {
+        result.emplace_back(mWarps[mPositions.at(name)]);
+    }
+    return result;
+}
+
+WarpStorage::TagIndex const& WarpStorage::getTagIndex() const { return mTagIndex; }
+
+WarpStorage::Warps WarpStorage::getWarpsByTag(std::string const& tag) const {
+    auto iter = mTagIndex.find(tag);
+    if (iter == mTagIndex.end()) {
+        return {};
+    }
+    std::vector<std::size_t> indexes;
+    indexes.reserve(iter->second.size());
+    for (auto const& name : iter->second) {
+        indexes.push_back(mPositions.at(name));
+    }
+    std::sort(indexes.begin(), indexes.end());
+
     Warps result;
-    for (auto const& warp : mWarps) {
-        if (warp.name.find(keyword) != std::string::npos) {
-            result.emplace_back(warp);
+    result.reserve(indexes.size());
+    for (auto index : indexes) {
+        result.emplace_back(mWarps[index]);
+    }
+    return result;
+}
+
+std::vector<std::string> WarpStorage::normalizeTags(std::vector<std::string> tags) {
+    std::vector<std::string> result;
+    result.reserve(tags.size());
+    for (auto& tag : tags) {
+        auto begin = tag.find_first_not_of(" \t");
+        if (begin == std::string::npos) {
+            continue;
+        }
+        auto end = tag.find_last_not_of(" \t");
+        tag      = tag.substr(begin, end - begin + 1);
+        if (std::find(result.begin(), result.end(), tag) == result.end()) {
+            result.push_back(std::move(tag));
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> WarpStorage::parseTags(std::string_view text) {
+    std::vector<std::string> tags;
+    std::string              current;
+    for (std::size_t i = 0; i < text.size();) {
+        if (text[i] == ',') {
+            tags.push_back(std::move(current));
+            current.clear();
+            i += 1;
+        } else if (text.substr(i).starts_with("，")) {
+            tags.push_back(std::move(current));
+            current.clear();
+            i += std::string_view{"，"}.size();
+        } else {
+            current.push_back(text[i]);
+            i += 1;
+        }
+    }
+    tags.push_back(std::move(current));
+    return normalizeTags(std::move(tags));
+}
+
+std::uint64_t WarpStorage::getVersion() const { return mVersion; }
+
+void WarpStorage::recordUse(std::string const& name) {
+    if (!hasWarp(name)) {
+        return;
+    }
+    auto  now   = nowSeconds();
+    auto& usage = mUsage[name];
+
+    usage.score     = decayedScore(usage, now) + 1.0;
+    usage.updatedAt = now;
+    usage.total++;
+}
+
+std::optional<WarpStorage::Usage> WarpStorage::getUsage(std::string const& name) const {
+    auto iter = mUsage.find(name);
+    if (iter == mUsage.end()) {
+        return std::nullopt;
+    }
+    return iter->second;
+}
+
+double WarpStorage::getScore(std::string const& name) const {
+    auto iter = mUsage.find(name);
+    return iter == mUsage.end() ? 0.0 : decayedScore(iter->second, nowSeconds());
+}
+
+void WarpStorage::_refreshRanking() const {
+    auto now = nowSeconds();
+    if (mRankedDataVersion == mVersion && now - mRankedAt < RankingRefreshSeconds) {
+        return;
+    }
+
+    std::vector<double> scores(mWarps.size(), 0.0);
+    for (std::size_t i = 0; i < mWarps.size(); ++i) {
+        if (auto iter = mUsage.find(mWarps[i].name); iter != mUsage.end()) {
+            scores[i] = decayedScore(iter->second, now);
         }
     }
+    std::vector<std::size_t> order(mWarps.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return scores[a] > scores[b]; });
+
+    // 传送点数据未变化且顺序相同时保留版本，菜单缓存继续有效
+    bool changed = mRankedDataVersion != mVersion || mRanked.size() != order.size();
+    for (std::size_t i = 0; !changed && i < order.size(); ++i) {
+        changed = mRanked[i].name != mWarps[order[i]].name;
+    }
+
+    if (changed) {
+        mRanked.clear();
+        mRanked.reserve(order.size());
+        for (auto index : order) {
+            mRanked.push_back(mWarps[index]);
+        }
+        mRankingVersion++;
+    }
+    mRankedDataVersion = mVersion;
+    mRankedAt          = now;
+}
+
+WarpStorage::Warps const& WarpStorage::getRankedWarps() const {
+    _refreshRanking();
+    return mRanked;
+}
+
+std::uint64_t WarpStorage::getRankingVersion() const {
+    _refreshRanking();
+    return mRankingVersion;
+}
+
+std::vector<std::pair<WarpStorage::Warp, float>>
+WarpStorage::getNearestWarps(int dimId, Vec3 const& pos, std::size_t count, float maxDistance) const {
+    std::vector<std::pair<Warp, float>> result;
+    for (auto const& [name, distance] : mSpatialIndex.nearest(dimId, pos.x, pos.y, pos.z, count, maxDistance)) {
+        result.emplace_back(mWarps[mPositions.at(name)], distance);
+    }
+    return result;
+}
+
+WarpStorage::Warps WarpStorage::getWarpsWithin(int dimId, Vec3 const& corner1, Vec3 const& corner2) const {
+    Warps result;
+    for (auto const& name : mSpatialIndex.within(dimId, corner1.x, corner1.z, corner2.x, corner2.z)) {
+        result.emplace_back(mWarps[mPositions.at(name)]);
+    }
     return result;
 }
 
 
 // Warp
-WarpStorage::Warp WarpStorage::Warp::make(Vec3 const& vec3, int dimid, std::string const& name) {
+WarpStorage::Warp
+WarpStorage::Warp::make(Vec3 const& vec3, int dimid, std::string const& name, std::vector<std::string> tags) {
     auto time = time_utils::getCurrentTimeString();
     return Warp{
         .x            = vec3.x,
@@ -128,7 +395,8 @@ WarpStorage::Warp WarpStorage::Warp::make(Vec3 const& vec3, int dimid, std::stri
         .dimid        = dimid,
         .createdTime  = time,
         .modifiedTime = std::move(time),
-        .name         = name
+        .name         = name,
+        .tags         = normalizeTags(std::move(tags))
     };
 }
 
@@ -1,5 +1,17 @@
 #pragma once
+#include "ltps/common/NameIndex.h"
+#include "ltps/common/SpatialIndex.h"
 #include "ltps/database/IStorage.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 class Vec3;
 class Player;
@@ -9,13 +21,15 @@ namespace ltps::warp {
 class WarpStorage final : public IStorage {
 public:
     struct Warp {
-        float       x, y, z;      // 位置
-        int         dimid;        // 维度
-        std::string createdTime;  // 创建时间
-        std::string modifiedTime; // 修改时间
-        std::string name;         // 名称
+        float                    x, y, z;      // 位置
+        int                      dimid;        // 维度
+        std::string              createdTime;  // 创建时间
+        std::string              modifiedTime; // 修改时间
+        std::string              name;         // 名称
+        std::vector<std::string> tags;         // 分类标签
 
-        TPSNDAPI static Warp make(Vec3 const& vec3, int dimid, std::string const& name);
+        TPSNDAPI static Warp
+        make(Vec3 const& vec3, int dimid, std::string const& name, std::vector<std::string> tags = {});
 
         TPSAPI void teleport(Player& player) const;
 
@@ -28,8 +42,38 @@ class WarpStorage final : public IStorage {
     };
     using Warps = std::vector<Warp>;
 
+    // 使用统计（单独存储，不改变传送点数据格式）
+    struct Usage {
+        double        score{0.0};  // 使用热度，每经过一个半衰期减半（截至 updatedAt）
+        std::int64_t  updatedAt{0}; // 最近使用时间（Unix 秒）
+        std::uint64_t total{0};     // 累计使用次数
+    };
+    using UsageMap = std::unordered_map<std::string, Usage>;
+
+    using TagIndex = std::map<std::string, std::set<std::string>>; // 标签 -> 传送点名称
+
+    static inline constexpr std::int64_t RankingRefreshSeconds = 60; // 热度排序最短刷新间隔
+
 private:
-    Warps mWarps;
+    Warps                                        mWarps;
+    std::unordered_map<std::string, std::size_t> mPositions; // 名称 -> mWarps 下标
+    NameIndex                                    mNameIndex; // 名称搜索索引
+    SpatialIndex<std::string>                    mSpatialIndex;
+    TagIndex                                     mTagIndex;   // 分类标签倒排索引
+    std::uint64_t                                mVersion{0}; // 数据版本，每次修改递增
+    UsageMap                                     mUsage;      // 名称 -> 使用统计
+    mutable Warps                                mRanked;     // 按热度降序的传送点（缓存，读取时按需刷新）
+    mutable std::uint64_t                        mRankingVersion{0};
+    mutable std::uint64_t                        mRankedDataVersion{0};
+    mutable std::int64_t                         mRankedAt{0};
+
+    void _loadUsage();
+    void _refreshRanking() const;
+
+    void _rebuildIndexes();
+    void _indexPosition(Warp const& warp);
+    void _indexTags(Warp const& warp);
+    void _unindexTags(Warp const& warp);
 
 public:
     TPS_DISALLOW_COPY_AND_MOVE(WarpStorage);
@@ -54,9 +98,47 @@ class WarpStorage final : public IStorage {
 
     TPSNDAPI std::vector<Warp> getWarps(int count) const;
 
-    TPSNDAPI Warps queryWarp(std::string const& keyword) const; // 模糊查询
+    // 模糊查询，按 完全匹配 > 前缀 > 子串 > 模糊 排序（支持拼音首字母）
+    TPSNDAPI Warps queryWarp(std::string const& keyword, std::size_t limit = NameIndex::DefaultLimit) const;
+
+    // 所有标签及其传送点名称，按标签排序
+    TPSNDAPI TagIndex const& getTagIndex() const;
+
+    // 带有指定标签的传送点（保持列表顺序），标签不存在时为空
+    TPSNDAPI Warps getWarpsByTag(std::string const& tag) const;
+
+    // 去除首尾空白、空标签与重复标签
+    TPSNDAPI static std::vector<std::string> normalizeTags(std::vector<std::string> tags);
+
+    // 解析逗号分隔的标签（支持全角逗号）
+    TPSNDAPI static std::vector<std::string> parseTags(std::string_view text);
+
+    // 数据版本（加载、增删改时递增），用于判断缓存是否过期
+    TPSNDAPI std::uint64_t getVersion() const;
+
+    // 记录一次使用（传送完成后调用），只更新内存中的计数
+    TPSAPI void recordUse(std::string const& name);
+
+    TPSNDAPI std::optional<Usage> getUsage(std::string const& name) const;
+
+    // 衰减到当前时间的使用热度
+    TPSNDAPI double getScore(std::string const& name) const;
+
+    // 按热度降序的传送点（热度相同保持原顺序），最多每 RankingRefreshSeconds 秒重新排序一次
+    TPSNDAPI Warps const& getRankedWarps() const;
+
+    // 排序结果版本，顺序或传送点数据变化时递增，用于判断缓存是否过期
+    TPSNDAPI std::uint64_t getRankingVersion() const;
+
+    // 最近的 count 个传送点及距离，按距离升序
+    TPSNDAPI std::vector<std::pair<Warp, float>>
+             getNearestWarps(int dimId, Vec3 const& pos, std::size_t count, float maxDistance = 1e9f) const;
+
+    // 水平范围内的传送点
+    TPSNDAPI Warps getWarpsWithin(int dimId, Vec3 const& corner1, Vec3 const& corner2) const;
 
     static inline constexpr auto STORAGE_KEY = "warp";
+    static inline constexpr auto USAGE_KEY   = "warp_usage";
 };
 
 } // namespace ltps::warp
@@ -96,6 +96,9 @@ warp::WarpStorage::Warp const& ITeleportWarpEvent::getWarp() const { return mWar
 WarpTeleportingEvent::WarpTeleportingEvent(Player& player, warp::WarpStorage::Warp const& warp)
 : ITeleportWarpEvent(player, warp) {}
 
+void      WarpTeleportingEvent::setCharged(long long charged) { mCharged = charged; }
+long long WarpTeleportingEvent::getCharged() const { return mCharged; }
+
 WarpTeleportedEvent::WarpTeleportedEvent(Player& player, warp::WarpStorage::Warp const& warp)
 : ITeleportWarpEvent(player, warp) {}
 
@@ -138,34 +141,50 @@ IMPL_EVENT_EMITTER(AdminTeleportedWarpEvent);
 IAdminCreateWarpEvent::IAdminCreateWarpEvent(
     Player& admin,
 
-    std::string name,
-    int         dimid,
-    Vec3        position
+    std::string              name,
+    int                      dimid,
+    Vec3                     position,
+    std::vector<std::string> tags
 )
 : IAdminEvent(admin),
   mName(std::move(name)),
   mDimid(dimid),
-  mPosition(position) {}
+  mPosition(position),
+  mTags(std::move(tags)) {}
 
-std::string const& IAdminCreateWarpEvent::getName() const { return mName; }
-int                IAdminCreateWarpEvent::getDimid() const { return mDimid; }
-Vec3 const&        IAdminCreateWarpEvent::getPosition() const { return mPosition; }
+std::string const&              IAdminCreateWarpEvent::getName() const { return mName; }
+int                             IAdminCreateWarpEvent::getDimid() const { return mDimid; }
+Vec3 const&                     IAdminCreateWarpEvent::getPosition() const { return mPosition; }
+std::vector<std::string> const& IAdminCreateWarpEvent::getTags() const { return mTags; }
 
 
 // AdminRequestCreateWarpEvent & AdminCreateingWarpEvent & AdminCreatedWarpEvent
 AdminRequestCreateWarpEvent::AdminRequestCreateWarpEvent(
-    Player&     admin,
-    std::string homeName,
-    int         dimid,
-    Vec3        homePosition
+    Player&                  admin,
+    std::string              homeName,
+    int                      dimid,
+    Vec3                     homePosition,
+    std::vector<std::string> tags
 )
-: IAdminCreateWarpEvent(admin, std::move(homeName), dimid, homePosition) {}
+: IAdminCreateWarpEvent(admin, std::move(homeName), dimid, homePosition, std::move(tags)) {}
 
-AdminCreateingWarpEvent::AdminCreateingWarpEvent(Player& admin, std::string homeName, int dimid, Vec3 homePosition)
-: IAdminCreateWarpEvent(admin, std::move(homeName), dimid, homePosition) {}
+AdminCreateingWarpEvent::AdminCreateingWarpEvent(
+    Player&                  admin,
+    std::string              homeName,
+    int                      dimid,
+    Vec3                     homePosition,
+    std::vector<std::string> tags
+)
+: IAdminCreateWarpEvent(admin, std::move(homeName), dimid, homePosition, std::move(tags)) {}
 
-AdminCreatedWarpEvent::AdminCreatedWarpEvent(Player& admin, std::string homeName, int dimid, Vec3 homePosition)
-: IAdminCreateWarpEvent(admin, std::move(homeName), dimid, homePosition) {}
+AdminCreatedWarpEvent::AdminCreatedWarpEvent(
+    Player&                  admin,
+    std::string              homeName,
+    int                      dimid,
+    Vec3                     homePosition,
+    std::vector<std::string> tags
+)
+: IAdminCreateWarpEvent(admin, std::move(homeName), dimid, homePosition, std::move(tags)) {}
 
 IMPL_EVENT_EMITTER(AdminRequestCreateWarpEvent);
 IMPL_EVENT_EMITTER(AdminCreateingWarpEvent);
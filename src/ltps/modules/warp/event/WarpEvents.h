@@ -52,8 +52,13 @@ class ITeleportWarpEvent {
 };
 
 class WarpTeleportingEvent final : public Cancellable<Event>, public ITeleportWarpEvent {
+    long long mCharged{0}; // 监听者扣除的费用，传送被分发队列丢弃时退还
+
 public:
     TPSAPI explicit WarpTeleportingEvent(Player& player, WarpStorage::Warp const& warp);
+
+    TPSAPI void        setCharged(long long charged);
+    TPSNDAPI long long getCharged() const;
 };
 
 class WarpTeleportedEvent final : public Event, public ITeleportWarpEvent {
@@ -181,16 +186,24 @@ class AdminTeleportedWarpEvent final : public Event, public IAdminOperateWarpEve
 
 class IAdminCreateWarpEvent : public IAdminEvent {
 protected:
-    std::string mName;     // 公共传送点的名字
-    int         mDimid;    // 公共传送点的维度
-    Vec3        mPosition; // 公共传送点的位置
+    std::string              mName;     // 公共传送点的名字
+    int                      mDimid;    // 公共传送点的维度
+    Vec3                     mPosition; // 公共传送点的位置
+    std::vector<std::string> mTags;     // 公共传送点的分类标签
 
 public:
-    TPSAPI explicit IAdminCreateWarpEvent(Player& admin, std::string name, int dimid, Vec3 position);
+    TPSAPI explicit IAdminCreateWarpEvent(
+        Player&                  admin,
+        std::string              name,
+        int                      dimid,
+        Vec3                     position,
+        std::vector<std::string> tags = {}
+    );
 
-    TPSNDAPI std::string const& getName() const;
-    TPSNDAPI int                getDimid() const;
-    TPSNDAPI Vec3 const&        getPosition() const;
+    TPSNDAPI std::string const&              getName() const;
+    TPSNDAPI int                             getDimid() const;
+    TPSNDAPI Vec3 const&                     getPosition() const;
+    TPSNDAPI std::vector<std::string> const& getTags() const;
 };
 
 /**
@@ -198,17 +211,35 @@ class IAdminCreateWarpEvent : public IAdminEvent {
  */
 class AdminRequestCreateWarpEvent final : public Event, public IAdminCreateWarpEvent {
 public:
-    TPSAPI explicit AdminRequestCreateWarpEvent(Player& admin, std::string name, int dimid, Vec3 homePosition);
+    TPSAPI explicit AdminRequestCreateWarpEvent(
+        Player&                  admin,
+        std::string              name,
+        int                      dimid,
+        Vec3                     homePosition,
+        std::vector<std::string> tags = {}
+    );
 };
 
 class AdminCreateingWarpEvent final : public Cancellable<Event>, public IAdminCreateWarpEvent {
 public:
-    TPSAPI explicit AdminCreateingWarpEvent(Player& admin, std::string name, int dimid, Vec3 homePosition);
+    TPSAPI explicit AdminCreateingWarpEvent(
+        Player&                  admin,
+        std::string              name,
+        int                      dimid,
+        Vec3                     homePosition,
+        std::vector<std::string> tags = {}
+    );
 };
 
 class AdminCreatedWarpEvent final : public Event, public IAdminCreateWarpEvent {
 public:
-    TPSAPI explicit AdminCreatedWarpEvent(Player& admin, std::string name, int dimid, Vec3 homePosition);
+    TPSAPI explicit AdminCreatedWarpEvent(
+        Player&                  admin,
+        std::string              name,
+        int                      dimid,
+        Vec3                     homePosition,
+        std::vector<std::string> tags = {}
+    );
 };
 
 
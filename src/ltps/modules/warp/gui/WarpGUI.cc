@@ -1,11 +1,14 @@
 #include "WarpGUI.h"
 
 #include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
+#include "ltps/common/RateLimiter.h"
 #include "ltps/modules/warp/event/WarpEvents.h"
 #include "ltps/utils/McUtils.h"
 
 #include <ll/api/event/EventBus.h>
 #include <ll/api/form/CustomForm.h>
+#include <algorithm>
 
 namespace ltps::warp {
 
@@ -63,6 +66,10 @@ void WarpGUI::_sendFuzzySearchGUI(Player& player, ChooseWarpCB callback) {
             mc_utils::sendText<mc_utils::Error>(self, "名称不能为空"_trl(self.getLocaleCode()));
             return;
         }
+        if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(self)) {
+            limiter.sendRateLimitedMessage(self);
+            return;
+        }
         _sendChooseWarpGUI(
             self,
             TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>()->queryWarp(name),
@@ -72,26 +79,118 @@ void WarpGUI::_sendFuzzySearchGUI(Player& player, ChooseWarpCB callback) {
 }
 
 void WarpGUI::_sendChooseWarpGUI(Player& player, WarpStorage::Warps const& warps, ChooseWarpCB callback) {
-    auto localeCode = player.getLocaleCode();
-    auto fm         = BackSimpleForm::make<WarpGUI::sendMainMenu>(nullptr);
-    fm.setTitle("Warp - 选择传送点"_trl(localeCode));
-    fm.setContent("请选择一个要前往的传送点"_trl(localeCode));
-    fm.appendButton(
+    auto& session = TeleportSystem::getInstance().getSessionManager().getSession(player);
+    _buildChooseWarpGUI(session.getLocaleCode(), warps, std::move(callback))->sendTo(player);
+}
+
+FormCache::FormPtr
+WarpGUI::_buildChooseWarpGUI(std::string const& localeCode, WarpStorage::Warps const& warps, ChooseWarpCB callback) {
+    auto fm = std::make_shared<BackSimpleForm>(
+        BackSimpleForm::makeCallback<WarpGUI::sendMainMenu>(nullptr),
+        BackSimpleForm::ButtonPos::Upper
+    );
+    fm->setTitle("Warp - 选择传送点"_trl(localeCode));
+    fm->setContent("请选择一个要前往的传送点"_trl(localeCode));
+    fm->appendButton(
         "模糊搜索"_trl(localeCode),
         "textures/ui/magnifyingGlass",
         "path",
         [rawCB = callback](Player& self) { _sendFuzzySearchGUI(self, rawCB); }
     );
     for (auto const& warp : warps) {
-        fm.appendButton(warp.name, [warp, cb = callback](Player& self) { cb(self, warp); });
+        fm->appendButton(warp.name, [warp, cb = callback](Player& self) { cb(self, warp); });
+    }
+    return fm;
+}
+
+void WarpGUI::sendCachedChooseWarpGUI(Player& player, std::string_view kind, ChooseWarpCB callback) {
+    auto storage    = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
+    auto localeCode = TeleportSystem::getInstance().getSessionManager().getSession(player).getLocaleCode();
+
+    FormCache::FormPtr fm;
+    if (getConfig().modules.warp.usage.rankMenus) {
+        auto rankedKind = std::string{kind} + ".ranked";
+        fm = FormCache::getInstance().getOrBuild(rankedKind, localeCode, storage->getRankingVersion(), [&] {
+            return _buildChooseWarpGUI(localeCode, storage->getRankedWarps(), std::move(callback));
+        });
+    } else {
+        fm = FormCache::getInstance().getOrBuild(kind, localeCode, storage->getVersion(), [&] {
+            return _buildChooseWarpGUI(localeCode, storage->getWarps(), std::move(callback));
+        });
+    }
+    fm->sendTo(player);
+}
+
+void WarpGUI::sendCachedTagWarpGUI(
+    Player&            player,
+    std::string_view   kind,
+    std::string const& tag,
+    ChooseWarpCB       callback
+) {
+    auto storage    = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
+    auto localeCode = TeleportSystem::getInstance().getSessionManager().getSession(player).getLocaleCode();
+    auto tagKind    = fmt::format("{}.tag.{}", kind, tag);
+
+    FormCache::FormPtr fm;
+    if (getConfig().modules.warp.usage.rankMenus) {
+        fm = FormCache::getInstance().getOrBuild(tagKind + ".ranked", localeCode, storage->getRankingVersion(), [&] {
+            auto warps = storage->getWarpsByTag(tag);
+            std::stable_sort(warps.begin(), warps.end(), [&](WarpStorage::Warp const& a, WarpStorage::Warp const& b) {
+                return storage->getScore(a.name) > storage->getScore(b.name);
+            });
+            return _buildChooseWarpGUI(localeCode, warps, std::move(callback));
+        });
+    } else {
+        fm = FormCache::getInstance().getOrBuild(tagKind, localeCode, storage->getVersion(), [&] {
+            return _buildChooseWarpGUI(localeCode, storage->getWarpsByTag(tag), std::move(callback));
+        });
     }
-    fm.sendTo(player);
+    fm->sendTo(player);
+}
+
+void WarpGUI::sendCategoryGUI(Player& player, std::string_view kind, ChooseWarpCB callback) {
+    auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
+    if (storage->getTagIndex().empty()) {
+        sendCachedChooseWarpGUI(player, kind, std::move(callback));
+        return;
+    }
+
+    auto localeCode = TeleportSystem::getInstance().getSessionManager().getSession(player).getLocaleCode();
+    auto fm         = FormCache::getInstance().getOrBuild(
+        fmt::format("{}.tags", kind),
+        localeCode,
+        storage->getVersion(),
+        [&] {
+            auto form = std::make_shared<BackSimpleForm>(
+                BackSimpleForm::makeCallback<WarpGUI::sendMainMenu>(nullptr),
+                BackSimpleForm::ButtonPos::Upper
+            );
+            form->setTitle("Warp - 选择分类"_trl(localeCode));
+            form->setContent("请选择一个分类"_trl(localeCode));
+            form->appendButton(
+                "全部传送点 ({})"_trl(localeCode, storage->getWarps().size()),
+                "textures/ui/world_glyph_color",
+                "path",
+                [kind = std::string{kind}, callback](Player& self) { sendCachedChooseWarpGUI(self, kind, callback); }
+            );
+            for (auto const& [tag, names] : storage->getTagIndex()) {
+                form->appendButton(
+                    fmt::format("{} ({})", tag, names.size()),
+                    [kind = std::string{kind}, tag, callback](Player& self) {
+                        sendCachedTagWarpGUI(self, kind, tag, callback);
+                    }
+                );
+            }
+            return form;
+        }
+    );
+    fm->sendTo(player);
 }
 
 
 void WarpGUI::sendGoWarpGUI(Player& player) {
-    sendChooseNameGUI(player, [](Player& self, std::string name) {
-        ll::event::EventBus::getInstance().publish(PlayerRequestGoWarpEvent{self, name});
+    sendCategoryGUI(player, "warp.go", [](Player& self, WarpStorage::Warp const& warp) {
+        ll::event::EventBus::getInstance().publish(PlayerRequestGoWarpEvent{self, warp.name});
     });
 }
 
@@ -107,13 +206,17 @@ void WarpGUI::sendAddWarpGUI(Player& player) {
                 mc_utils::sendText<mc_utils::Error>(self, "名称不能为空"_trl(self.getLocaleCode()));
                 return;
             }
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(self)) {
+                limiter.sendRateLimitedMessage(self);
+                return;
+            }
             ll::event::EventBus::getInstance().publish(PlayerRequestAddWarpEvent{self, name});
         });
 }
 
 void WarpGUI::sendRemoveWarpGUI(Player& player) {
-    sendChooseNameGUI(player, [](Player& self, std::string name) {
-        ll::event::EventBus::getInstance().publish(PlayerRequestRemoveWarpEvent{self, name});
+    sendCategoryGUI(player, "warp.remove", [](Player& self, WarpStorage::Warp const& warp) {
+        ll::event::EventBus::getInstance().publish(PlayerRequestRemoveWarpEvent{self, warp.name});
     });
 }
 
@@ -1,7 +1,9 @@
 #pragma once
 #include "ltps/Global.h"
 #include "ltps/common/BackSimpleForm.h"
+#include "ltps/common/FormCache.h"
 #include "ltps/modules/warp/WarpStorage.h"
+#include <string_view>
 
 class Player;
 
@@ -21,6 +23,22 @@ class WarpGUI {
     TPSAPI static void _sendFuzzySearchGUI(Player& player, ChooseWarpCB callback);
     TPSAPI static void _sendChooseWarpGUI(Player& player, WarpStorage::Warps const& warps, ChooseWarpCB callback);
 
+    TPSNDAPI static FormCache::FormPtr
+    _buildChooseWarpGUI(std::string const& localeCode, WarpStorage::Warps const& warps, ChooseWarpCB callback);
+
+    /**
+     * @brief 发送完整传送点列表，表单按 kind + 语言 + 存储版本缓存并在玩家间复用
+     * callback 不能捕获玩家状态，同一 kind 必须始终传入相同行为的回调。
+     */
+    TPSAPI static void sendCachedChooseWarpGUI(Player& player, std::string_view kind, ChooseWarpCB callback);
+
+    // 发送某个标签下的传送点列表（由标签索引查询），缓存规则同 sendCachedChooseWarpGUI
+    TPSAPI static void
+    sendCachedTagWarpGUI(Player& player, std::string_view kind, std::string const& tag, ChooseWarpCB callback);
+
+    // 按分类选择传送点：先选择标签再选择传送点，没有任何标签时直接发送完整列表
+    TPSAPI static void sendCategoryGUI(Player& player, std::string_view kind, ChooseWarpCB callback);
+
     TPSAPI static void sendGoWarpGUI(Player& player);
     TPSAPI static void sendAddWarpGUI(Player& player);
     TPSAPI static void sendRemoveWarpGUI(Player& player);
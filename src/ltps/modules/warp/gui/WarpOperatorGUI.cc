@@ -1,13 +1,16 @@
 #include "WarpOperatorGUI.h"
 
+#include "fmt/ranges.h"
 #include "ll/api/event/EventBus.h"
 #include "ll/api/form/CustomForm.h"
 #include "ll/api/form/SimpleForm.h"
 #include "ltps/Global.h"
 #include "ltps/TeleportSystem.h"
 #include "ltps/common/BackSimpleForm.h"
+#include "ltps/common/RateLimiter.h"
 #include "ltps/modules/warp/event/WarpEvents.h"
 #include "ltps/utils/McUtils.h"
+#include "ltps/utils/TimeUtils.h"
 #include "mc/world/level/dimension/VanillaDimensions.h"
 #include <utility>
 
@@ -49,16 +52,27 @@ void WarpOperatorGUI::sendChooseWarpGUI(Player& player, ChooseWarpCallback callb
 
 void WarpOperatorGUI::sendOperatorMenu(Player& player, WarpStorage::Warp warp) {
     auto localeCode = player.getLocaleCode();
+    auto storage    = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
+    auto usage      = storage->getUsage(warp.name);
+    auto lastUsed   = usage ? time_utils::timeToString(time_utils::Clock::from_time_t(usage->updatedAt))
+                            : "从未使用"_trl(localeCode);
+    auto tags       = warp.tags.empty() ? "无"_trl(localeCode) : fmt::format("{}", fmt::join(warp.tags, ", "));
 
     BackSimpleForm::make<sendChooseWarpGUI>(sendOperatorMenu)
         .setTitle("Teleport System - Warp Manager"_trl(localeCode))
-        .setContent("名称: {}\n坐标: {}\n创建时间: {}\n修改时间: {}"_trl(
-            localeCode,
-            warp.name,
-            warp.toPosString(),
-            warp.createdTime,
-            warp.modifiedTime
-        ))
+        .setContent(
+            "名称: {}\n坐标: {}\n标签: {}\n创建时间: {}\n修改时间: {}\n使用次数: {}\n热度: {:.2f}\n最近使用: {}"_trl(
+                localeCode,
+                warp.name,
+                warp.toPosString(),
+                tags,
+                warp.createdTime,
+                warp.modifiedTime,
+                usage ? usage->total : 0,
+                storage->getScore(warp.name),
+                lastUsed
+            )
+        )
         .appendButton(
             "前往"_trl(localeCode),
             "textures/ui/send_icon",
@@ -118,6 +132,13 @@ void WarpOperatorGUI::sendCreateOrEditWarpGUI(Player& player, std::optional<Warp
     }
 
     fm.appendDropdown("dimName", "请选择一个维度: "_trl(localeCode), dimNames, index);
+    fm.appendInput(
+        "tags",
+        "请输入分类标签: "_trl(localeCode),
+        "string",
+        warp ? fmt::format("{}", fmt::join(warp->tags, ",")) : "",
+        "多个标签使用逗号分隔, 留空则不分类"_trl(localeCode)
+    );
 
     fm.sendTo(
         player,
@@ -126,6 +147,10 @@ void WarpOperatorGUI::sendCreateOrEditWarpGUI(Player& player, std::optional<Warp
             if (!result) {
                 return;
             }
+            if (auto& limiter = RateLimiter::getInstance(); !limiter.tryAcquire(self)) {
+                limiter.sendRateLimitedMessage(self);
+                return;
+            }
 
             auto name = std::get<std::string>(result->at("name"));
 
@@ -166,11 +191,14 @@ void WarpOperatorGUI::sendCreateOrEditWarpGUI(Player& player, std::optional<Warp
                 }
             }
 
+            auto tags = WarpStorage::parseTags(std::get<std::string>(result->at("tags")));
             if (warp) {
-                auto newWarp = WarpStorage::Warp::make(v3, dimid, name);
+                auto newWarp = WarpStorage::Warp::make(v3, dimid, name, std::move(tags));
                 ll::event::EventBus::getInstance().publish(AdminRequestEditWarpEvent{self, warp.value(), newWarp});
             } else {
-                ll::event::EventBus::getInstance().publish(AdminRequestCreateWarpEvent{self, name, dimid, v3});
+                ll::event::EventBus::getInstance().publish(
+                    AdminRequestCreateWarpEvent{self, name, dimid, v3, std::move(tags)}
+                );
             }
         }
     );
@@ -0,0 +1,83 @@
+#include "ltps/modules/tpr/RejectedRegionCache.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace ltps::test {
+
+using tpr::RejectedRegionCache;
+
+
+static void check(std::string const& name, bool ok) {
+    std::cout << "[RejectedRegionCache] " << name << (ok ? "" : "  MISMATCH!") << std::endl;
+}
+
+
+void RejectedRegionCacheTest() {
+    using namespace std::chrono_literals;
+
+    auto const now = RejectedRegionCache::Clock::now();
+
+    // 网格键：同一网格内的点共享记录，负坐标向下取整，维度互不影响
+    {
+        RejectedRegionCache cache{32, 16, 10min};
+        cache.reject(0, 5, 5, now);
+        cache.reject(0, -1, -1, now);
+        check(
+            "cell keys",
+            cache.isRejected(0, 31, 0, now) && !cache.isRejected(0, 32, 0, now) && cache.isRejected(0, -32, -32, now)
+                && !cache.isRejected(0, -33, -1, now) && !cache.isRejected(1, 5, 5, now)
+        );
+    }
+
+    // 超出容量时淘汰最久未被拒绝的记录，重复拒绝刷新顺序
+    {
+        RejectedRegionCache cache{16, 2, 10min};
+        cache.reject(0, 0, 0, now);
+        cache.reject(0, 16, 0, now);
+        cache.reject(0, 0, 0, now);  // 刷新，16 变为最旧
+        cache.reject(0, 32, 0, now); // 淘汰 16
+        check(
+            "lru eviction",
+            cache.size() == 2 && cache.isRejected(0, 0, 0, now) && !cache.isRejected(0, 16, 0, now)
+                && cache.isRejected(0, 32, 0, now)
+        );
+    }
+
+    // 过期后不再拒绝并移除记录，重复拒绝刷新有效期
+    {
+        RejectedRegionCache cache{16, 16, 10s};
+        cache.reject(0, 0, 0, now);
+        cache.reject(0, 16, 0, now);
+        cache.reject(0, 16, 0, now + 8s);
+        check(
+            "ttl",
+            cache.isRejected(0, 0, 0, now + 9s) && !cache.isRejected(0, 0, 0, now + 10s)
+                && cache.isRejected(0, 16, 0, now + 15s) && cache.size() == 1
+        );
+    }
+
+    // 重新配置：参数不变时保留记录，容量缩小时淘汰最旧记录，网格变化时清空
+    {
+        RejectedRegionCache cache{16, 16, 10min};
+        cache.reject(0, 0, 0, now);
+        cache.reject(0, 16, 0, now);
+        cache.reject(0, 32, 0, now);
+        cache.configure(16, 16, 10min);
+        bool kept = cache.size() == 3;
+        cache.configure(16, 2, 10min);
+        bool trimmed = cache.size() == 2 && !cache.isRejected(0, 0, 0, now);
+        cache.configure(32, 2, 10min);
+        check("configure", kept && trimmed && cache.size() == 0);
+    }
+
+    // 容量为 0 时不记录（功能关闭）
+    {
+        RejectedRegionCache cache{16, 0, 10min};
+        cache.reject(0, 0, 0, now);
+        check("disabled", cache.size() == 0 && !cache.isRejected(0, 0, 0, now));
+    }
+}
+
+
+} // namespace ltps::test
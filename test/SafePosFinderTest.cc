@@ -0,0 +1,177 @@
+#include "ltps/modules/tpr/ColumnSnapshot.h"
+#include "ltps/modules/tpr/SafePosFinder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ltps::test {
+
+using tpr::ColumnBlock;
+using tpr::IColumnView;
+using tpr::SafePosFinder;
+using tpr::SafePosSearchStats;
+
+
+// 合成单列数据
+class SyntheticColumn final : public IColumnView {
+    int                      mMinY;
+    std::vector<ColumnBlock> mBlocks;
+
+public:
+    SyntheticColumn(int minY, int maxY) : mMinY(minY), mBlocks(maxY - minY, ColumnBlock::Air) {}
+
+    SyntheticColumn& fill(int fromY, int toY, ColumnBlock block) {
+        for (int y = fromY; y <= toY; ++y) {
+            mBlocks[y - mMinY] = block;
+        }
+        return *this;
+    }
+
+    int getMinY() const override { return mMinY; }
+    int getMaxY() const override { return mMinY + static_cast<int>(mBlocks.size()); }
+
+    std::optional<int> getHeightmap() const override {
+        for (int y = getMaxY() - 1; y >= mMinY; --y) {
+            if (mBlocks[y - mMinY] != ColumnBlock::Air) {
+                return y + 1;
+            }
+        }
+        return mMinY;
+    }
+
+    bool isSectionEmpty(int sectionIndex) const override {
+        auto begin = sectionIndex * SafePosFinder::SectionHeight;
+        for (int i = begin; i < begin + SafePosFinder::SectionHeight && i < static_cast<int>(mBlocks.size()); ++i) {
+            if (mBlocks[i] != ColumnBlock::Air) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ColumnBlock getBlock(int y) const override {
+        if (y < mMinY || y >= getMaxY()) {
+            return ColumnBlock::Air;
+        }
+        return mBlocks[y - mMinY];
+    }
+};
+
+
+// 按游戏内的复制方式生成快照：Air=0 Solid=1 Dangerous=2，只复制高度图以下的非空子区块
+static tpr::ColumnSnapshot toSnapshot(SyntheticColumn const& column, int startY, int depth) {
+    auto heightmap = column.getHeightmap();
+    auto topY      = heightmap && *heightmap <= startY ? *heightmap : startY + 1;
+    auto bottomY   = std::max(column.getMinY(), topY - depth);
+
+    auto snapshot = tpr::ColumnSnapshot{0, 0, column.getMinY(), column.getMaxY(), bottomY, topY, heightmap, 0};
+    for (int y = bottomY; y < std::min(topY, column.getMaxY()); ++y) {
+        auto section = (y - column.getMinY()) / SafePosFinder::SectionHeight;
+        if (column.isSectionEmpty(section)) {
+            snapshot.markSectionEmpty(section);
+            continue;
+        }
+        snapshot.set(y, static_cast<std::uint32_t>(column.getBlock(y)));
+    }
+    return snapshot;
+}
+
+
+static void runCase(std::string const& name, SyntheticColumn const& column, int startY) {
+    SafePosSearchStats linearStats, newStats;
+
+    auto linear = SafePosFinder::findLinear(column, startY, &linearStats);
+    auto result = SafePosFinder::find(column, startY, &newStats);
+
+    // 快照分析（线程池中执行的路径）
+    tpr::BlockIdSet dangerous;
+    dangerous.insert(static_cast<std::uint32_t>(ColumnBlock::Dangerous));
+    auto full      = tpr::findInSnapshots({toSnapshot(column, startY, 1 << 16)}, startY, dangerous);
+    auto snapshotY = full.found ? std::optional<int>{full.found->y} : std::nullopt;
+
+    // 只复制 16 格：找到时与完整结果一致，否则标记为需要更深的范围
+    auto partial  = tpr::findInSnapshots({toSnapshot(column, startY, 16)}, startY, dangerous);
+    bool windowOk = partial.found ? partial.found->y == snapshotY
+                                  : (!partial.incomplete.empty() || !snapshotY.has_value());
+
+    auto toString = [](std::optional<int> const& v) { return v ? std::to_string(*v) : std::string{"none"}; };
+
+    constexpr int Rounds = 10000;
+    auto          bench  = [&](auto&& fn) {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < Rounds; ++i) {
+            (void)fn(column, startY, nullptr);
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / Rounds;
+    };
+    auto linearUs = bench(SafePosFinder::findLinear);
+    auto newUs    = bench(SafePosFinder::find);
+
+    std::cout << "[SafePosFinder] " << name << ": linear=" << toString(linear) << " (" << linearStats.blockReads
+              << " reads, " << linearUs << "us)"
+              << ", heightmap=" << toString(result) << " (" << newStats.blockReads << " reads + "
+              << newStats.sectionChecks << " section checks, " << newUs << "us)"
+              << ", snapshot=" << toString(snapshotY) << (partial.incomplete.empty() ? "" : " (deeper copy needed)")
+              << (linear == result && result == snapshotY && windowOk ? "" : "  MISMATCH!")
+              << std::endl;
+}
+
+
+void SafePosFinderTest() {
+    // 主世界平原：-64 基岩，石头到 60，泥土到 63，草方块 64
+    auto plains = SyntheticColumn(-64, 320)
+                      .fill(-64, -64, ColumnBlock::Solid)
+                      .fill(-63, 63, ColumnBlock::Solid)
+                      .fill(64, 64, ColumnBlock::Solid);
+    runCase("overworld plains", plains, 320);
+
+    // 海洋：海床 40，水到 62，危险方块
+    auto ocean = SyntheticColumn(-64, 320).fill(-64, 40, ColumnBlock::Solid).fill(41, 62, ColumnBlock::Dangerous);
+    runCase("overworld ocean", ocean, 320);
+
+    // 地下洞穴：地表为岩浆，30~40 为洞穴
+    auto cave = SyntheticColumn(-64, 320)
+                    .fill(-64, 29, ColumnBlock::Solid)
+                    .fill(41, 70, ColumnBlock::Solid)
+                    .fill(71, 71, ColumnBlock::Dangerous);
+    runCase("lava surface + cave", cave, 320);
+
+    // 下界：顶部基岩，起点为 mMax - 5
+    auto nether = SyntheticColumn(0, 128)
+                      .fill(0, 31, ColumnBlock::Solid)
+                      .fill(32, 40, ColumnBlock::Dangerous)
+                      .fill(70, 80, ColumnBlock::Solid)
+                      .fill(110, 127, ColumnBlock::Solid);
+    runCase("nether", nether, 128 - 5);
+
+    // 虚空
+    runCase("void", SyntheticColumn(-64, 320), 320);
+
+    // 螺旋偏移：半径 r 内恰好遍历 (2r+1)^2 列且不重复
+    std::set<std::pair<int, int>> visited;
+    bool                          ordered = true;
+    int                           lastRing = 0;
+    SafePosFinder::forEachSpiralOffset(3, [&](int dx, int dz) {
+        auto ring = std::max(std::abs(dx), std::abs(dz));
+        ordered   = ordered && ring >= lastRing;
+        lastRing  = ring;
+        visited.emplace(dx, dz);
+        return false;
+    });
+    auto const& table = SafePosFinder::getSpiralOffsets();
+    bool        prefix =
+        static_cast<int>(table.size()) == SafePosFinder::spiralCount(SafePosFinder::ChunkWidth)
+        && std::set<std::pair<int, int>>(table.begin(), table.begin() + SafePosFinder::spiralCount(3)) == visited;
+    std::cout << "[SafePosFinder] spiral: " << visited.size() << "/49 columns"
+              << (visited.size() == 49 && ordered && prefix ? "" : "  MISMATCH!") << std::endl;
+}
+
+
+} // namespace ltps::test
@@ -4,8 +4,14 @@
 namespace ltps::test {
 
 extern void PriceCalculateTest();
+extern void SafePosFinderTest();
+extern void RejectedRegionCacheTest();
 
-void Test_Main() { PriceCalculateTest(); }
+void Test_Main() {
+    PriceCalculateTest();
+    SafePosFinderTest();
+    RejectedRegionCacheTest();
+}
 
 
 } // namespace ltps::test